@@ -0,0 +1,289 @@
+#ifndef TASTYLIB_ADDRESSABLEHEAP_H_
+#define TASTYLIB_ADDRESSABLEHEAP_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A binary heap whose elements can be changed or removed after insertion.
+Each pushed element gets a handle that stays valid until the element is
+popped or erased, no matter how the element moves in the tree. Handles
+of removed elements are reused by later insertions.
+
+Compared with pushing duplicates into a BinaryHeap and skipping the
+stale ones on pop, the heap only holds live elements.
+
+@param Value The type of the value stored in the heap
+@param Pred  The type of the binary predicate to arrange tree the nodes.
+             The heap ensures that for each node N in the tree,
+             N.value == N.parent.value OR Pred(N.value, N.parent.value) == true.
+             By default it uses operator '>=' as the predicate, which makes it
+             a min-root heap.
+*/
+template<typename Value, typename Pred = std::greater_equal<Value>>
+class AddressableHeap {
+public:
+    typedef std::size_t SizeType;
+    typedef SizeType Handle;
+
+    /*
+    Destructor.
+    */
+    ~AddressableHeap() {}
+
+    /*
+    Default constructor.
+    */
+    AddressableHeap() {}
+
+    /*
+    Return the amount of elements in the heap.
+    */
+    SizeType getSize() const {
+        return tree.size();
+    }
+
+    /*
+    Return true if the heap has no elements.
+    */
+    bool isEmpty() const {
+        return tree.empty();
+    }
+
+    /*
+    Clear the elements in the heap. All handles become invalid.
+    */
+    void clear() {
+        tree.clear();
+        pos.clear();
+        freeHandles.clear();
+    }
+
+    /*
+    Return true if a handle refers to an element in the heap.
+
+    @param h The handle to be checked
+    */
+    bool contains(const Handle h) const {
+        return h < pos.size() && pos[h] != NPOS;
+    }
+
+    /*
+    Return the value of an element.
+    Precondition: contains(h) == true.
+
+    @param h The handle of the element
+    */
+    const Value& get(const Handle h) const {
+        return tree[pos[h]].val;
+    }
+
+    /*
+    Insert a new element to the heap.
+
+    @param val The value of the element to be inserted
+    @return    The handle of the new element
+    */
+    Handle push(const Value &val) {
+        Handle h;
+        if (freeHandles.empty()) {
+            h = pos.size();
+            pos.push_back(NPOS);
+        } else {
+            h = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        tree.push_back(Node{val, h});
+        siftUp(tree.size() - 1, Node{val, h});
+        return h;
+    }
+
+    /*
+    Return the root element of the heap.
+    Precondition: The heap is non-empty.
+    */
+    const Value& top() const {
+        return tree[0].val;
+    }
+
+    /*
+    Return the handle of the root element.
+    Precondition: The heap is non-empty.
+    */
+    Handle topHandle() const {
+        return tree[0].handle;
+    }
+
+    /*
+    Remove the root element of the heap and maintain the nodes order.
+    Precondition: The heap is non-empty.
+    */
+    void pop() {
+        removeAt(0);
+    }
+
+    /*
+    Remove an element from the heap in O(logn) time.
+
+    @param h The handle of the element
+    @return  False if the handle refers to no element.
+    */
+    bool erase(const Handle h) {
+        if (!contains(h)) {
+            return false;
+        }
+        removeAt(pos[h]);
+        return true;
+    }
+
+    /*
+    Change the value of an element to one that moves it toward the root,
+    e.g. a smaller value in a min-root heap. It takes O(logn) time.
+
+    @param h   The handle of the element
+    @param val The new value. Pred(old value, val) must be true.
+    @return    False if the handle refers to no element or the new
+               value violates the precondition, and nothing is changed.
+    */
+    bool decreaseKey(const Handle h, const Value &val) {
+        if (!contains(h) || !pred(tree[pos[h]].val, val)) {
+            return false;
+        }
+        siftUp(pos[h], Node{val, h});
+        return true;
+    }
+
+    /*
+    Change the value of an element to one that moves it away from the
+    root, e.g. a larger value in a min-root heap. It takes O(logn) time.
+
+    @param h   The handle of the element
+    @param val The new value. Pred(val, old value) must be true.
+    @return    False if the handle refers to no element or the new
+               value violates the precondition, and nothing is changed.
+    */
+    bool increaseKey(const Handle h, const Value &val) {
+        if (!contains(h) || !pred(val, tree[pos[h]].val)) {
+            return false;
+        }
+        siftDown(pos[h], Node{val, h});
+        return true;
+    }
+
+    /*
+    Change the value of an element in O(logn) time. The element moves
+    toward or away from the root as the new value requires.
+
+    @param h   The handle of the element
+    @param val The new value
+    @return    False if the handle refers to no element.
+    */
+    bool update(const Handle h, const Value &val) {
+        if (!contains(h)) {
+            return false;
+        }
+        place(pos[h], Node{val, h});
+        return true;
+    }
+
+private:
+    /*
+    Position of the handles that refer to no element.
+    */
+    static const SizeType NPOS = (SizeType)-1;
+
+    struct Node {
+        Value val;
+        Handle handle;
+    };
+
+    Pred pred;
+
+    /*
+    Store the complete binary tree in an array named 'tree'.
+    The root is stored at tree[0], the children of node i are
+    tree[2 * i + 1] and tree[2 * i + 2], and the parent of
+    node i is tree[floor((i - 1) / 2)]. Each node carries its
+    handle, so moving a node only touches the tree and 'pos'.
+    */
+    std::vector<Node> tree;
+    std::vector<SizeType> pos;  // Position in the tree of each handle
+    std::vector<Handle> freeHandles;
+
+    /*
+    Move a node to tree[i] and record its new position.
+    */
+    void set(const SizeType i, const Node &node) {
+        tree[i] = node;
+        pos[node.handle] = i;
+    }
+
+    /*
+    Put a node into the hole at tree[i] and percolate it up.
+    */
+    void siftUp(SizeType i, const Node &node) {
+        while (i != 0) {
+            SizeType p = (i - 1) >> 1;
+            if (pred(node.val, tree[p].val)) {
+                break;
+            }
+            set(i, tree[p]);
+            i = p;
+        }
+        set(i, node);
+    }
+
+    /*
+    Put a node into the hole at tree[i] and percolate it down.
+    */
+    void siftDown(SizeType i, const Node &node) {
+        const SizeType n = tree.size();
+        SizeType child;
+        while ((child = 2 * i + 1) < n) {
+            if (child + 1 < n && pred(tree[child].val, tree[child + 1].val)) {
+                ++child;
+            }
+            if (pred(tree[child].val, node.val)) {
+                break;
+            }
+            set(i, tree[child]);
+            i = child;
+        }
+        set(i, node);
+    }
+
+    /*
+    Put a node into the hole at tree[i] and percolate it
+    in the direction that its value requires.
+    */
+    void place(const SizeType i, const Node &node) {
+        if (i != 0 && !pred(node.val, tree[(i - 1) >> 1].val)) {
+            siftUp(i, node);
+        } else {
+            siftDown(i, node);
+        }
+    }
+
+    /*
+    Remove the node at tree[i] and fill the hole with the last node.
+    */
+    void removeAt(const SizeType i) {
+        pos[tree[i].handle] = NPOS;
+        freeHandles.push_back(tree[i].handle);
+        Node last = tree.back();
+        tree.pop_back();
+        if (i < tree.size()) {
+            place(i, last);
+        }
+    }
+};
+
+template<typename Value, typename Pred>
+const typename AddressableHeap<Value, Pred>::SizeType AddressableHeap<Value, Pred>::NPOS;
+
+TASTYLIB_NS_END
+
+#endif
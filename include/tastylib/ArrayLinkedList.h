@@ -0,0 +1,614 @@
+#ifndef TASTYLIB_ARRAYLINKEDLIST_H_
+#define TASTYLIB_ARRAYLINKEDLIST_H_
+
+#include "tastylib/internal/base.h"
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <new>
+
+TASTYLIB_NS_BEGIN
+
+/*
+Doubly linked list whose nodes are stored in one growable array.
+Nodes are linked by array indices instead of pointers, and the
+slots of removed nodes are reused through a free list. It has
+the same interface as DoublyLinkedList except splice() and merge(),
+since nodes cannot move between two arrays without being copied.
+
+Growing the array and sorting the list lay the nodes out in list
+order, so traversing the list afterwards reads memory sequentially.
+Both operations invalidate all iterators.
+
+@param Value The type of list node value.
+@param Pred  A binary predicate that checks if two node values
+             are equal. If Pred(a, b) == true, then value 'a'
+             and value 'b' are considered equal.
+@param Index The unsigned integer type of node indices. It limits
+             the maximum amount of nodes in the list to getMaxSize(),
+             since its largest value marks null nodes. Inserting
+             more nodes than that is undefined.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>,
+         typename Index = std::uint32_t>
+class ArrayLinkedList {
+public:
+    struct Node {
+        Value val;
+        Index prev;
+        Index next;
+
+        Node(const Value &v, const Index p, const Index n)
+            : val(v), prev(p), next(n) {}
+
+        Node(Value &&v, const Index p, const Index n)
+            : val(std::move(v)), prev(p), next(n) {}
+    };
+
+    typedef std::size_t SizeType;
+
+    /*
+    Index of a null node.
+    */
+    static const Index NIL = (Index)-1;
+
+    /*
+    Bidirectional iterator of the list. Decrementing the
+    end iterator moves it to the last node of the list.
+
+    @param Ref The reference type of the node value
+    @param Ptr The pointer type of the node value
+    */
+    template<typename Ref, typename Ptr>
+    class IteratorImpl {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+
+        IteratorImpl() : node(NIL), list(nullptr) {}
+
+        /*
+        Copy constructor. It also converts a mutable
+        iterator to a constant one.
+        */
+        IteratorImpl(const IteratorImpl<Value&, Value*> &it)
+            : node(it.node), list(it.list) {}
+
+        IteratorImpl& operator=(const IteratorImpl &it) = default;
+
+        Ref operator*() const {
+            return list->nodes[node].val;
+        }
+
+        Ptr operator->() const {
+            return &list->nodes[node].val;
+        }
+
+        IteratorImpl& operator++() {
+            node = list->nodes[node].next;
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            node = (node != NIL ? list->nodes[node].prev : list->tail);
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl &it) const {
+            return node == it.node;
+        }
+
+        bool operator!=(const IteratorImpl &it) const {
+            return node != it.node;
+        }
+
+    private:
+        friend class ArrayLinkedList;
+        template<typename, typename> friend class IteratorImpl;
+
+        Index node;
+        const ArrayLinkedList *list;
+
+        IteratorImpl(const Index n, const ArrayLinkedList *l)
+            : node(n), list(l) {}
+    };
+
+    typedef IteratorImpl<Value&, Value*> Iterator;
+    typedef IteratorImpl<const Value&, const Value*> ConstIterator;
+
+    /*
+    Destructor.
+    */
+    ~ArrayLinkedList() {
+        clear();
+        ::operator delete(nodes);
+    }
+
+    /*
+    Default constructor.
+    */
+    ArrayLinkedList()
+        : size(0), head(NIL), tail(NIL), freeHead(NIL),
+          used(0), capacity(0), nodes(nullptr) {}
+
+    ArrayLinkedList(const ArrayLinkedList &) = delete;
+    ArrayLinkedList& operator=(const ArrayLinkedList &) = delete;
+
+    /*
+    Return the amount of nodes in the list.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the list is empty.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Return the amount of nodes the array can hold without growing.
+    */
+    SizeType getCapacity() const {
+        return capacity;
+    }
+
+    /*
+    Return the maximum amount of nodes in the list.
+    */
+    static SizeType getMaxSize() {
+        return (SizeType)NIL;
+    }
+
+    /*
+    Clear the content of the list. The array is kept for reuse.
+    */
+    void clear() {
+        for (Index i = head, next; i != NIL; i = next) {
+            next = nodes[i].next;
+            nodes[i].~Node();
+        }
+        size = 0;
+        used = 0;
+        head = tail = freeHead = NIL;
+    }
+
+    /*
+    Make the array large enough to hold a given amount of nodes.
+
+    @param n The expected amount of nodes
+    */
+    void reserve(const SizeType n) {
+        if (n > capacity) {
+            relocate(std::min(n, getMaxSize()));
+        }
+    }
+
+    /*
+    Return an iterator to the first node of the list.
+    */
+    Iterator begin() {
+        return Iterator(head, this);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(head, this);
+    }
+
+    /*
+    Return an iterator to the position past the last node of the list.
+    */
+    Iterator end() {
+        return Iterator(NIL, this);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(NIL, this);
+    }
+
+    /*
+    Traverse the list node.
+
+    @param f The function to traverse each list node. Params are:
+             @param pos The position of the current traversing node
+             @param val The value of the current traversing node
+    */
+    void traverse(const std::function<void(const SizeType pos,
+                                           const Value &val)> &f) const {
+        SizeType pos = 0;
+        for (Index i = head; i != NIL; i = nodes[i].next, ++pos) {
+            f(pos, nodes[i].val);
+        }
+    }
+
+    /*
+    Find a node in the list.
+
+    @param val_ The value of the node to be found
+    @return     The first matching position of the node with value 'val_'.
+                If the node does not exist, return -1.
+    */
+    int find(const Value &val_) const {
+        Pred pred;
+        SizeType pos = 0;
+        for (Index i = head; i != NIL; i = nodes[i].next, ++pos) {
+            if (pred(nodes[i].val, val_)) {
+                return (int)pos;
+            }
+        }
+        return -1;
+    }
+
+    /*
+    Find the first node whose value satisfies a predicate.
+
+    @param f A unary predicate that accepts a node value
+    @return  The iterator to the first matching node. If no
+             node matches, return end().
+    */
+    template<typename UnaryPred>
+    Iterator findIf(const UnaryPred &f) {
+        Index i = head;
+        while (i != NIL && !f(nodes[i].val)) {
+            i = nodes[i].next;
+        }
+        return Iterator(i, this);
+    }
+
+    template<typename UnaryPred>
+    ConstIterator findIf(const UnaryPred &f) const {
+        Index i = head;
+        while (i != NIL && !f(nodes[i].val)) {
+            i = nodes[i].next;
+        }
+        return ConstIterator(i, this);
+    }
+
+    /*
+    Insert a node at a given position. If the position is greater than
+    the list's size, the node will be inserted to the back of the list.
+    Precondition: getSize() < getMaxSize().
+
+    @param pos The position to insert the node
+    @param val The value of the node to be inserted
+    */
+    void insert(SizeType pos, const Value &val) {
+        pos = (pos > size ? size : pos);
+        Index i = allocate(val);
+        link(pos == size ? NIL : getNode(pos), i);
+    }
+
+    /*
+    Insert a node before the node that an iterator points to.
+    The iterator must be obtained after the last growth of the array.
+
+    @param pos The iterator before which the node is inserted
+    @param val The value of the node to be inserted
+    @return    The iterator to the inserted node
+    */
+    Iterator insert(ConstIterator pos, const Value &val) {
+        Index p = pos.node;
+        if (p != NIL && freeHead == NIL && used == capacity) {
+            // Growing relocates the nodes in list order, so
+            // the node at rank k will be stored at index k.
+            Index rank = 0;
+            for (Index i = head; i != p; i = nodes[i].next) {
+                ++rank;
+            }
+            Value tmp(val);
+            relocate(grownCapacity());
+            p = rank;
+            Index n = allocate(tmp);
+            link(p, n);
+            return Iterator(n, this);
+        }
+        Index n = allocate(val);
+        link(p, n);
+        return Iterator(n, this);
+    }
+
+    /*
+    Insert a node at the front of the list.
+
+    @param val The value of the node to be inserted
+    */
+    void insertFront(const Value &val) {
+        Index i = allocate(val);
+        link(head, i);
+    }
+
+    /*
+    Insert a node at the back of the list.
+
+    @param val The value of the node to be inserted
+    */
+    void insertBack(const Value &val) {
+        Index i = allocate(val);
+        link(NIL, i);
+    }
+
+    /*
+    Remove a node at a given position. If there is no node
+    at the given position, this function does nothing.
+
+    @param pos The position of the node to be removed
+    */
+    void remove(SizeType pos) {
+        if (pos < size) {
+            release(getNode(pos));
+        }
+    }
+
+    /*
+    Remove the node that an iterator points to. The iterator
+    becomes invalid after its execution.
+    Precondition: The iterator points to a node of the list.
+
+    @param pos The iterator to the node to be removed
+    @return    The iterator to the node next to the removed one
+    */
+    Iterator erase(ConstIterator pos) {
+        Index next = nodes[pos.node].next;
+        release(pos.node);
+        return Iterator(next, this);
+    }
+
+    /*
+    Remove the nodes in the range [first, last).
+
+    @param first The iterator to the first node to be removed
+    @param last  The iterator past the last node to be removed
+    @return      The iterator 'last'
+    */
+    Iterator erase(ConstIterator first, ConstIterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return Iterator(last.node, this);
+    }
+
+    /*
+    Remove the first node of the list.
+    */
+    void removeFront() {
+        if (!isEmpty()) {
+            release(head);
+        }
+    }
+
+    /*
+    Remove the last node of the list.
+    */
+    void removeBack() {
+        if (!isEmpty()) {
+            release(tail);
+        }
+    }
+
+    /*
+    Sort the list nodes in ascending order.
+    */
+    void sort() {
+        sort(std::less<Value>());
+    }
+
+    /*
+    Sort the list nodes in custom order. The sort is stable, and
+    the nodes are laid out in list order in the array afterwards.
+
+    @param cmp A binary predicate to compare two node values. The sorting
+               algorithm ensures that after its execution, for each node A
+               and its next node B in the list, A.value == B.value OR
+               cmp(A.value, B.value) == true.
+    */
+    template<typename Comparator>
+    void sort(const Comparator &cmp) {
+        std::vector<Value> vals;
+        vals.reserve(size);
+        for (Index i = head, next; i != NIL; i = next) {
+            next = nodes[i].next;
+            vals.push_back(std::move(nodes[i].val));
+            nodes[i].~Node();
+        }
+        std::stable_sort(vals.begin(), vals.end(), cmp);
+        for (SizeType i = 0; i < size; ++i) {
+            new (nodes + i) Node(std::move(vals[i]),
+                                 (Index)(i == 0 ? NIL : i - 1),
+                                 (Index)(i + 1 == size ? NIL : i + 1));
+        }
+        used = (Index)size;
+        freeHead = NIL;
+        head = (size ? 0 : NIL);
+        tail = (size ? (Index)(size - 1) : NIL);
+    }
+
+private:
+    SizeType size;
+    Index head;
+    Index tail;
+
+    // Head of the singly linked list of free slots below 'used'
+    Index freeHead;
+
+    // Slots at and above 'used' have never been allocated
+    Index used;
+
+    SizeType capacity;
+    Node *nodes;
+
+    /*
+    Construct a detached node in a free slot. Grow the array if it is full.
+
+    @param val The value of the node
+    @return    The index of the node
+    */
+    Index allocate(const Value &val) {
+        Index i;
+        if (freeHead != NIL) {
+            i = freeHead;
+            freeHead = nextFree(i);
+        } else {
+            if (used == capacity) {
+                // 'val' may refer to a node of this list
+                Value tmp(val);
+                relocate(grownCapacity());
+                i = used++;
+                new (nodes + i) Node(std::move(tmp), NIL, NIL);
+                return i;
+            }
+            i = used++;
+        }
+        new (nodes + i) Node(val, NIL, NIL);
+        return i;
+    }
+
+    /*
+    Return the capacity after the array grows. It never exceeds
+    getMaxSize(), so no node is stored at index NIL.
+    */
+    SizeType grownCapacity() const {
+        return std::min(capacity ? capacity << 1 : MIN_CAPACITY, getMaxSize());
+    }
+
+    /*
+    Unlink a node, destroy it and put its slot into the free list.
+
+    @param i The index of the node
+    */
+    void release(const Index i) {
+        unlink(i);
+        nodes[i].~Node();
+        // A Node holds an Index, so the slot is large and aligned enough
+        new (nodes + i) Index(freeHead);
+        freeHead = i;
+        --size;
+    }
+
+    /*
+    Return the next free slot stored in a free slot by release().
+    */
+    Index nextFree(const Index i) const {
+        return *reinterpret_cast<const Index*>(nodes + i);
+    }
+
+    /*
+    Move all nodes to a new array of a given capacity in list order.
+
+    @param cap The capacity of the new array
+    */
+    void relocate(const SizeType cap) {
+        Node *newNodes = static_cast<Node*>(::operator new(cap * sizeof(Node)));
+        Index k = 0;
+        for (Index i = head, next; i != NIL; i = next, ++k) {
+            next = nodes[i].next;
+            new (newNodes + k) Node(std::move(nodes[i].val),
+                                    (Index)(k == 0 ? NIL : k - 1),
+                                    (Index)((SizeType)k + 1 == size ? NIL : k + 1));
+            nodes[i].~Node();
+        }
+        ::operator delete(nodes);
+        nodes = newNodes;
+        capacity = cap;
+        used = (Index)size;
+        freeHead = NIL;
+        head = (size ? 0 : NIL);
+        tail = (size ? (Index)(size - 1) : NIL);
+    }
+
+    /*
+    Link a detached node before a given node.
+
+    @param pos The node before which the node is linked. If it is
+               NIL, the node is linked to the back of the list.
+    @param i   The node to be linked
+    */
+    void link(const Index pos, const Index i) {
+        Node &n = nodes[i];
+        n.next = pos;
+        n.prev = (pos != NIL ? nodes[pos].prev : tail);
+        if (n.prev != NIL) {
+            nodes[n.prev].next = i;
+        } else {
+            head = i;
+        }
+        if (pos != NIL) {
+            nodes[pos].prev = i;
+        } else {
+            tail = i;
+        }
+        ++size;
+    }
+
+    /*
+    Detach a node from the list without destroying it.
+
+    @param i The node to be detached
+    */
+    void unlink(const Index i) {
+        const Node &n = nodes[i];
+        if (n.prev != NIL) {
+            nodes[n.prev].next = n.next;
+        } else {
+            head = n.next;
+        }
+        if (n.next != NIL) {
+            nodes[n.next].prev = n.prev;
+        } else {
+            tail = n.prev;
+        }
+    }
+
+    /*
+    Return the node at a given position, walking from the nearer end.
+
+    @param pos The given position. Its value must lie in the interval [0, size).
+    */
+    Index getNode(const SizeType pos) const {
+        Index i;
+        if (pos < size - pos) {
+            i = head;
+            for (SizeType k = 0; k < pos; ++k) {
+                i = nodes[i].next;
+            }
+        } else {
+            i = tail;
+            for (SizeType k = size - 1; k > pos; --k) {
+                i = nodes[i].prev;
+            }
+        }
+        return i;
+    }
+
+    static const SizeType MIN_CAPACITY = 8;
+};
+
+template<typename Value, typename Pred, typename Index>
+const Index ArrayLinkedList<Value, Pred, Index>::NIL;
+
+template<typename Value, typename Pred, typename Index>
+const typename ArrayLinkedList<Value, Pred, Index>::SizeType
+ArrayLinkedList<Value, Pred, Index>::MIN_CAPACITY;
+
+TASTYLIB_NS_END
+
+#endif
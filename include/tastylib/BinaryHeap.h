@@ -2,14 +2,16 @@
 #define TASTYLIB_BINARYHEAP_H_
 
 #include "tastylib/internal/base.h"
+#include "tastylib/util/aligned_allocator.h"
 #include <functional>
 #include <vector>
-#include <stdexcept>
+#include <iterator>
+#include <utility>
 
 TASTYLIB_NS_BEGIN
 
 /*
-A heap data structure taking the form of a complete binary tree.
+A heap data structure taking the form of a complete d-ary tree.
 
 @param Value The type of the value stored in the heap
 @param Pred  The type of the binary predicate to arrange tree the nodes.
@@ -17,11 +19,18 @@ A heap data structure taking the form of a complete binary tree.
              N.value == N.parent.value OR Pred(N.value, N.parent.value) == true.
              By default it uses operator '>=' as the predicate, which makes it
              a min-root heap.
+@param Arity The amount of children of each node, which is 2, 4 or 8. A
+             larger arity makes the tree shallower, and the children of a
+             node share one cache line as long as they fit in 64 bytes.
 */
-template<typename Value, typename Pred = std::greater_equal<Value>>
+template<typename Value, typename Pred = std::greater_equal<Value>,
+         std::size_t Arity = 2>
 class BinaryHeap {
 public:
-    typedef std::vector<Value> Container;
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8,
+                  "The arity of BinaryHeap must be 2, 4 or 8.");
+
+    typedef std::vector<Value, AlignedAllocator<Value, 64, sizeof(Value)>> Container;
     typedef typename Container::size_type SizeType;
 
     /*
@@ -32,27 +41,59 @@ public:
     /*
     Default constructor.
     */
-    BinaryHeap() : size(0), tree(1, 0) {}
+    BinaryHeap() {}
+
+    /*
+    Build a heap from the values in a range in O(n) time.
+
+    @param first The iterator to the first value
+    @param last  The iterator past the last value
+    */
+    template<typename InputIt>
+    BinaryHeap(InputIt first, InputIt last) : tree(first, last) {
+        heapify();
+    }
+
+    /*
+    Build a heap from the values in a vector in O(n) time.
+
+    @param vals The values to be inserted
+    */
+    explicit BinaryHeap(const std::vector<Value> &vals)
+        : tree(vals.begin(), vals.end()) {
+        heapify();
+    }
+
+    /*
+    Build a heap from the values in a vector in O(n) time.
+    The values are moved into the heap.
+
+    @param vals The values to be inserted
+    */
+    explicit BinaryHeap(std::vector<Value> &&vals)
+        : tree(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end())) {
+        heapify();
+    }
 
     /*
     Return the amount of elements in the heap.
     */
     SizeType getSize() const {
-        return size;
+        return tree.size();
     }
 
     /*
     Return true if the heap has no elements.
     */
     bool isEmpty() const {
-        return size == 0;
+        return tree.empty();
     }
 
     /*
     Clear the elements in the heap.
     */
     void clear() {
-        size = 0;
+        tree.clear();
     }
 
     /*
@@ -61,23 +102,59 @@ public:
     @param val The value of the element to be inserted
     */
     void push(const Value &val) {
-        if (size + 1 == tree.size()) {  // The tree array is full
-            tree.resize(tree.size() << 1);  // Expand space
-        }
-        // The new element percolates up in the heap
-        SizeType i;
-        for (i = ++size; i != 1 && !pred(val, tree[i >> 1]); i >>= 1) {
-            tree[i] = tree[i >> 1];
+        tree.push_back(val);
+        siftUp(tree.size() - 1);
+    }
+
+    /*
+    Insert a new element to the heap. The value is moved into the heap.
+
+    @param val The value of the element to be inserted
+    */
+    void push(Value &&val) {
+        tree.push_back(std::move(val));
+        siftUp(tree.size() - 1);
+    }
+
+    /*
+    Insert a new element constructed in place from the given arguments.
+
+    @param args The arguments to construct the value
+    */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        tree.emplace_back(std::forward<Args>(args)...);
+        siftUp(tree.size() - 1);
+    }
+
+    /*
+    Insert the values in a range. If the range is at least as large as
+    the heap, the whole heap is rebuilt in O(n) time. Otherwise the
+    values are inserted one by one.
+
+    @param first The iterator to the first value
+    @param last  The iterator past the last value
+    */
+    template<typename InputIt>
+    void pushRange(InputIt first, InputIt last) {
+        const SizeType oldSize = tree.size();
+        tree.insert(tree.end(), first, last);
+        const SizeType added = tree.size() - oldSize;
+        if (added >= oldSize) {
+            heapify();
+        } else {
+            for (SizeType i = oldSize; i < tree.size(); ++i) {
+                siftUp(i);
+            }
         }
-        tree[i] = val;
     }
 
     /*
     Return the root element of the heap.
     Precondition: The heap is non-empty.
     */
-    Value top() const {
-        return tree[1];
+    const Value& top() const {
+        return tree[ROOT];
     }
 
     /*
@@ -85,40 +162,163 @@ public:
     Precondition: The heap is non-empty.
     */
     void pop() {
-        Value last = tree[size--];
-        SizeType i, child;
-        // The empty hole(root) percolates down in the heap
-        for (i = 1; (i << 1) <= size; i = child) {
-            child = i << 1;
-            if (child != size && pred(tree[child], tree[child + 1])) {
-                ++child;
-            }
-            if (pred(tree[child], last)) {
-                break;
-            } else {
-                tree[i] = tree[child];
-            }
+        Value last(std::move(tree.back()));
+        tree.pop_back();
+        const SizeType end = tree.size();
+        if (end == 0) {
+            return;
         }
-        tree[i] = last;
+        SizeType i = ROOT, child;
+        // The empty hole(root) moves down along the best children to
+        // a leaf, and then the last element percolates up from there.
+        // Most last elements belong near the leaves, so this saves the
+        // comparison with the last element at each level.
+        while ((child = firstChild(i)) < end) {
+            SizeType best = bestChild(child, end);
+            tree[i] = std::move(tree[best]);
+            i = best;
+        }
+        for (; i != ROOT && !pred(last, tree[parent(i)]); i = parent(i)) {
+            tree[i] = std::move(tree[parent(i)]);
+        }
+        tree[i] = std::move(last);
+    }
+
+    /*
+    Remove the root element of the heap and return it.
+    The value is moved out of the heap.
+    Precondition: The heap is non-empty.
+    */
+    Value popTop() {
+        Value res(std::move(tree[ROOT]));
+        pop();
+        return res;
+    }
+
+    /*
+    Replace the root element with a new value and maintain the nodes
+    order with a single percolation down. It costs about half of a pop()
+    followed by a push().
+    Precondition: The heap is non-empty.
+
+    @param val The new value
+    */
+    void replaceTop(const Value &val) {
+        tree[ROOT] = val;
+        siftDown(ROOT);
+    }
+
+    /*
+    Replace the root element with a new value and maintain the nodes
+    order with a single percolation down. The value is moved into the heap.
+    Precondition: The heap is non-empty.
+
+    @param val The new value
+    */
+    void replaceTop(Value &&val) {
+        tree[ROOT] = std::move(val);
+        siftDown(ROOT);
     }
 
 private:
-    SizeType size;
+    /*
+    Index of the root node in the tree array.
+    */
+    static const SizeType ROOT = 0;
+
     Pred pred;
 
     /*
-    Store the complete binary tree in an array named 'tree'.
-    The first element is stored at tree[1]. The value of
-    tree[0] has no use.
+    Store the complete d-ary tree in an array named 'tree'. The root
+    is stored at tree[0]. For each node i in the tree:
+    1. tree[d * i + 1 .. d * i + d] are the node values of its children.
+    2. tree[floor((i - 1) / d)] is the node value of its parent.
 
-    For each node i in the tree:
-    1. tree[2 * i] is the node value of its left child.
-    2. tree[2 * i + 1] is the node value of its right child.
-    3. tree[floor(i / 2)] is the node value if its parent node.
+    The array memory starts one value before a cache line, so tree[1]
+    starts at a cache line and all children of a node lie in one
+    aligned block of d values.
     */
     Container tree;
+
+    static SizeType firstChild(const SizeType i) {
+        return Arity * i + 1;
+    }
+
+    static SizeType parent(const SizeType i) {
+        return (i - 1) / Arity;
+    }
+
+    /*
+    Return the index of the best child among the children starting at
+    tree[child]. The selection is written to compile to conditional moves.
+
+    @param child The index of the first child
+    @param end   The amount of nodes in the tree
+    */
+    SizeType bestChild(const SizeType child, const SizeType end) const {
+        SizeType best = child;
+        if (child + Arity <= end) {  // All children exist
+            for (SizeType k = 1; k < Arity; ++k) {
+                best = (pred(tree[best], tree[child + k]) ? child + k : best);
+            }
+        } else {
+            for (SizeType k = child + 1; k < end; ++k) {
+                best = (pred(tree[best], tree[k]) ? k : best);
+            }
+        }
+        return best;
+    }
+
+    /*
+    Percolate up the value at tree[i].
+    */
+    void siftUp(SizeType i) {
+        if (i == ROOT || pred(tree[i], tree[parent(i)])) {
+            return;
+        }
+        Value val(std::move(tree[i]));
+        do {
+            tree[i] = std::move(tree[parent(i)]);
+            i = parent(i);
+        } while (i != ROOT && !pred(val, tree[parent(i)]));
+        tree[i] = std::move(val);
+    }
+
+    /*
+    Percolate down the value at tree[i].
+    */
+    void siftDown(SizeType i) {
+        const SizeType end = tree.size();
+        Value val(std::move(tree[i]));
+        SizeType child;
+        while ((child = firstChild(i)) < end) {
+            SizeType best = bestChild(child, end);
+            if (pred(tree[best], val)) {
+                break;
+            }
+            tree[i] = std::move(tree[best]);
+            i = best;
+        }
+        tree[i] = std::move(val);
+    }
+
+    /*
+    Rebuild the heap order of the whole tree in O(n) time
+    by percolating down each internal node from the last one.
+    */
+    void heapify() {
+        if (tree.size() < 2) {
+            return;
+        }
+        for (SizeType i = parent(tree.size() - 1) + 1; i-- > ROOT;) {
+            siftDown(i);
+        }
+    }
 };
 
+template<typename Value, typename Pred, std::size_t Arity>
+const typename BinaryHeap<Value, Pred, Arity>::SizeType BinaryHeap<Value, Pred, Arity>::ROOT;
+
 TASTYLIB_NS_END
 
 #endif
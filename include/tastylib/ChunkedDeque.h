@@ -0,0 +1,315 @@
+#ifndef TASTYLIB_CHUNKEDDEQUE_H_
+#define TASTYLIB_CHUNKEDDEQUE_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <new>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A double-ended queue that stores its values in fixed-size chunks. The
+chunk pointers are kept in a ring buffer, so both ends grow and shrink
+in O(1) time and a value at any position is reached in O(1) time. A
+chunk that becomes empty is kept in a pool of spare chunks and reused
+by later insertions, so a queue whose size stays bounded stops
+allocating memory.
+
+@param Value      The type of queue value.
+@param Pred       A binary predicate that checks if two values
+                  are equal. If Pred(a, b) == true, then value 'a'
+                  and value 'b' are considered equal.
+@param ChunkBytes The approximate size of a chunk in bytes. The amount
+                  of values in a chunk is rounded down to a power of 2.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>,
+         std::size_t ChunkBytes = 512>
+class ChunkedDeque {
+public:
+    typedef std::size_t SizeType;
+
+private:
+    static constexpr SizeType floorPow2(const SizeType n) {
+        return n < 2 ? 1 : 2 * floorPow2(n / 2);
+    }
+
+public:
+    /*
+    The amount of values in a chunk.
+    */
+    static const SizeType CHUNK_CAPACITY =
+        floorPow2(ChunkBytes / sizeof(Value) > 16 ? ChunkBytes / sizeof(Value) : 16);
+
+    /*
+    Destructor.
+    */
+    ~ChunkedDeque() {
+        clear();
+        delete[] map;
+    }
+
+    /*
+    Default constructor.
+    */
+    ChunkedDeque()
+        : size(0), first(0), map(nullptr), mapCapacity(0),
+          mapHead(0), chunkNum(0), spare(nullptr) {}
+
+    ChunkedDeque(const ChunkedDeque &) = delete;
+    ChunkedDeque& operator=(const ChunkedDeque &) = delete;
+
+    /*
+    Return the amount of values in the queue.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the queue is empty.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Clear the content of the queue. The memory of all chunks,
+    including the spare ones, is released.
+    */
+    void clear() {
+        for (SizeType i = 0; i < size; ++i) {
+            slot(i)->~Value();
+        }
+        for (SizeType i = 0; i < chunkNum; ++i) {
+            ::operator delete(chunkAt(i));
+        }
+        while (spare) {
+            SpareChunk *next = spare->next;
+            ::operator delete(spare);
+            spare = next;
+        }
+        size = first = mapHead = chunkNum = 0;
+    }
+
+    /*
+    Return the value at a given position.
+    Precondition: The position is less than the queue's size.
+
+    @param pos The position of the value
+    */
+    Value& operator[](const SizeType pos) {
+        return *slot(pos);
+    }
+
+    const Value& operator[](const SizeType pos) const {
+        return *slot(pos);
+    }
+
+    /*
+    Return the first value of the queue.
+    Precondition: The queue is not empty.
+    */
+    Value& front() {
+        return *slot(0);
+    }
+
+    const Value& front() const {
+        return *slot(0);
+    }
+
+    /*
+    Return the last value of the queue.
+    Precondition: The queue is not empty.
+    */
+    Value& back() {
+        return *slot(size - 1);
+    }
+
+    const Value& back() const {
+        return *slot(size - 1);
+    }
+
+    /*
+    Traverse the queue values.
+
+    @param f The function to traverse each value. Params are:
+             @param pos The position of the current traversing value
+             @param val The current traversing value
+    */
+    void traverse(const std::function<void(const SizeType pos,
+                                           const Value &val)> &f) const {
+        for (SizeType i = 0; i < size; ++i) {
+            f(i, *slot(i));
+        }
+    }
+
+    /*
+    Find a value in the queue.
+
+    @param val_ The value to be found
+    @return     The first matching position of the value 'val_'.
+                If the value does not exist, return -1.
+    */
+    int find(const Value &val_) const {
+        Pred pred;
+        for (SizeType i = 0; i < size; ++i) {
+            if (pred(*slot(i), val_)) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    /*
+    Insert a value at the front of the queue.
+
+    @param val The value to be inserted
+    */
+    void insertFront(const Value &val) {
+        if (first == 0) {
+            reserveChunk();
+            mapHead = (mapHead + mapCapacity - 1) & (mapCapacity - 1);
+            map[mapHead] = acquireChunk();
+            ++chunkNum;
+            first = CHUNK_CAPACITY;
+        }
+        new (chunkAt(0) + first - 1) Value(val);
+        --first;
+        ++size;
+    }
+
+    /*
+    Insert a value at the back of the queue.
+
+    @param val The value to be inserted
+    */
+    void insertBack(const Value &val) {
+        SizeType k = first + size;
+        if (k == chunkNum * CHUNK_CAPACITY) {
+            reserveChunk();
+            map[(mapHead + chunkNum) & (mapCapacity - 1)] = acquireChunk();
+            ++chunkNum;
+        }
+        new (chunkAt(k / CHUNK_CAPACITY) + k % CHUNK_CAPACITY) Value(val);
+        ++size;
+    }
+
+    /*
+    Remove the first value of the queue. If the queue
+    is empty, this function does nothing.
+    */
+    void removeFront() {
+        if (isEmpty()) {
+            return;
+        }
+        Value *v = chunkAt(0) + first;
+        v->~Value();
+        ++first;
+        --size;
+        if (first == CHUNK_CAPACITY || size == 0) {
+            releaseChunk(chunkAt(0));
+            mapHead = (mapHead + 1) & (mapCapacity - 1);
+            --chunkNum;
+            first = 0;
+        }
+    }
+
+    /*
+    Remove the last value of the queue. If the queue
+    is empty, this function does nothing.
+    */
+    void removeBack() {
+        if (isEmpty()) {
+            return;
+        }
+        slot(size - 1)->~Value();
+        --size;
+        if (first + size == (chunkNum - 1) * CHUNK_CAPACITY || size == 0) {
+            releaseChunk(chunkAt(chunkNum - 1));
+            --chunkNum;
+            if (size == 0) {
+                first = 0;
+            }
+        }
+    }
+
+private:
+    /*
+    A spare chunk. It is linked to the next spare
+    chunk through the memory of its values.
+    */
+    struct SpareChunk {
+        SpareChunk *next;
+    };
+
+    SizeType size;
+    SizeType first;        // Offset of the first value in the first chunk
+    Value **map;           // Ring buffer of chunk pointers
+    SizeType mapCapacity;  // Always 0 or a power of 2
+    SizeType mapHead;      // Index of the first chunk in the ring buffer
+    SizeType chunkNum;     // Amount of chunks in use
+    SpareChunk *spare;     // Head of the spare chunk pool
+
+    /*
+    Return the i-th chunk in use.
+    */
+    Value* chunkAt(const SizeType i) const {
+        return map[(mapHead + i) & (mapCapacity - 1)];
+    }
+
+    /*
+    Return the address of the value at a given position.
+    */
+    Value* slot(const SizeType pos) const {
+        SizeType k = first + pos;
+        return chunkAt(k / CHUNK_CAPACITY) + k % CHUNK_CAPACITY;
+    }
+
+    /*
+    Make sure the ring buffer has room for one more chunk.
+    */
+    void reserveChunk() {
+        if (chunkNum < mapCapacity) {
+            return;
+        }
+        SizeType newCapacity = (mapCapacity ? mapCapacity * 2 : 8);
+        Value **newMap = new Value*[newCapacity];
+        for (SizeType i = 0; i < chunkNum; ++i) {
+            newMap[i] = chunkAt(i);
+        }
+        delete[] map;
+        map = newMap;
+        mapCapacity = newCapacity;
+        mapHead = 0;
+    }
+
+    /*
+    Return a chunk from the spare pool, or allocate
+    a new one if the pool is empty.
+    */
+    Value* acquireChunk() {
+        if (spare) {
+            SpareChunk *c = spare;
+            spare = c->next;
+            return reinterpret_cast<Value*>(c);
+        }
+        return static_cast<Value*>(::operator new(CHUNK_CAPACITY * sizeof(Value)));
+    }
+
+    /*
+    Put an empty chunk back to the spare pool.
+    */
+    void releaseChunk(Value *chunk) {
+        SpareChunk *c = reinterpret_cast<SpareChunk*>(chunk);
+        c->next = spare;
+        spare = c;
+    }
+};
+
+template<typename Value, typename Pred, std::size_t ChunkBytes>
+const typename ChunkedDeque<Value, Pred, ChunkBytes>::SizeType
+ChunkedDeque<Value, Pred, ChunkBytes>::CHUNK_CAPACITY;
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef TASTYLIB_CONCURRENTHASHTABLE_H_
+#define TASTYLIB_CONCURRENTHASHTABLE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/internal/flat_table.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <utility>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A hash table that can be used by multiple threads at the same time.
+
+The elements are split into shards by the high bits of their hash values,
+and each shard is a flat open-addressing table like FlatHashTable guarded
+by its own reader-writer spin lock. Lookups of a shard share its lock and
+run in parallel, while insertions and removals lock it exclusively. A
+waiting writer blocks new readers, so writers are not starved. Threads
+working on different shards never wait for each other.
+
+The hash value of an element is computed once: its high bits select the
+shard, and its low bits select the slot in the shard.
+
+@param Value The type of the values stored in the hash table.
+@param Pred  A binary predicate that checks if two values are equal.
+             If pred(a, b) == true, then value 'a' and value 'b' are
+             considered equal.
+@param Hash  A unary functor that computes the hash value of an element.
+             Its result is mixed before use, so the identity hash of
+             integers works well.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>,
+         typename Hash = std::hash<Value>>
+class ConcurrentHashTable {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Initialize the hash table.
+
+    @param n        Expected amount of elements. The table grows
+                    automatically when more elements are inserted.
+    @param shardNum Expected amount of shards, which should be several
+                    times the amount of threads. In practice, it is
+                    rounded up to a power of 2.
+    */
+    explicit ConcurrentHashTable(const SizeType n = 0, const SizeType shardNum = 64)
+        : shardBits(0) {
+        while (((SizeType)1 << shardBits) < shardNum) {
+            ++shardBits;
+        }
+        shards = new Shard[(SizeType)1 << shardBits];
+        for (SizeType i = 0; i < getShardCount(); ++i) {
+            shards[i].state.store(0, std::memory_order_relaxed);
+            shards[i].size.store(0, std::memory_order_relaxed);
+            if (n > 0) {
+                shards[i].table.rehash(n / getShardCount() + 1);
+            }
+        }
+    }
+
+    /*
+    Destructor. It must not run concurrently with other operations.
+    */
+    ~ConcurrentHashTable() {
+        delete[] shards;
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable &) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable &) = delete;
+
+    /*
+    Return the amount of shards.
+    */
+    SizeType getShardCount() const {
+        return (SizeType)1 << shardBits;
+    }
+
+    /*
+    Return the amount of elements in the hash table. The result
+    is approximate while other threads modify the table.
+    */
+    SizeType getSize() const {
+        SizeType sum = 0;
+        for (SizeType i = 0; i < getShardCount(); ++i) {
+            sum += shards[i].size.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /*
+    Return true if the hash table has no elements. The result
+    is approximate while other threads modify the table.
+    */
+    bool isEmpty() const {
+        return getSize() == 0;
+    }
+
+    /*
+    Remove all elements from the hash table. The shards are
+    cleared one by one, each under its exclusive lock.
+    */
+    void clear() {
+        for (SizeType i = 0; i < getShardCount(); ++i) {
+            Shard &s = shards[i];
+            WriteGuard guard(s);
+            s.table.clear();
+        }
+    }
+
+    /*
+    Check if a value is in the hash table.
+
+    @param val The value to be checked
+    */
+    bool has(const Value &val) const {
+        const SizeType h = hash(val);
+        Shard &s = shardOf(h);
+        ReadGuard guard(s);
+        return s.table.findIndex(val, h) != Table::NPOS;
+    }
+
+    /*
+    Find a value in the hash table. A pointer to the stored value
+    would not be safe after the shard is unlocked, so the value is
+    copied out instead.
+
+    @param val The value to be found
+    @param res Output. The stored value that equals 'val'.
+    @return    True if the value is found.
+    */
+    bool find(const Value &val, Value &res) const {
+        const SizeType h = hash(val);
+        Shard &s = shardOf(h);
+        ReadGuard guard(s);
+        const SizeType i = s.table.findIndex(val, h);
+        if (i != Table::NPOS) {
+            res = s.table.slot(i);
+        }
+        return i != Table::NPOS;
+    }
+
+    /*
+    Insert a value to the hash table. If the
+    value exists, this function does nothing.
+
+    @param val The value to be inserted
+    @return    True if the value is inserted. When several threads insert
+               equal values at the same time, exactly one of them succeeds.
+    */
+    bool insert(const Value &val) {
+        return emplace(val);
+    }
+
+    /*
+    Insert a value to the hash table. The value is moved into the
+    table. If the value exists, this function does nothing.
+
+    @param val The value to be inserted
+    @return    True if the value is inserted.
+    */
+    bool insert(Value &&val) {
+        return emplace(std::move(val));
+    }
+
+    /*
+    Remove a value from the hash table. If the
+    value doesn't exist, this function does nothing.
+
+    @param val The value to be removed
+    @return    True if the value is removed.
+    */
+    bool remove(const Value &val) {
+        const SizeType h = hash(val);
+        Shard &s = shardOf(h);
+        WriteGuard guard(s);
+        const SizeType i = s.table.findIndex(val, h);
+        if (i != Table::NPOS) {
+            s.table.erase(i);
+        }
+        return i != Table::NPOS;
+    }
+
+private:
+    typedef internal::FlatTable<Value, internal::SlotIdentity, Pred, Hash> Table;
+
+    /*
+    Size of a cache line. The locks of different
+    shards are padded to different cache lines.
+    */
+    static const SizeType CACHE_LINE = 64;
+
+    /*
+    The bit of the lock state set by a writer. The other
+    bits count the readers holding the lock.
+    */
+    static const std::uint32_t WRITER = 0x80000000u;
+
+    /*
+    The amount of failed attempts to take a lock before
+    the thread yields its time slice.
+    */
+    static const int SPIN_LIMIT = 64;
+
+    struct Shard {
+        std::atomic<std::uint32_t> state;
+        std::atomic<SizeType> size;  // Size of the table for lock-free reads
+        Table table;
+        char pad[CACHE_LINE];
+    };
+
+    SizeType shardBits;
+    Shard *shards;
+
+    SizeType hash(const Value &val) const {
+        return shards[0].table.hash(val);
+    }
+
+    /*
+    Return the shard selected by the high bits of a hash value.
+    */
+    Shard& shardOf(const SizeType h) const {
+        return shards[shardBits == 0 ? 0 : h >> (sizeof(SizeType) * 8 - shardBits)];
+    }
+
+    static void backoff(int &spins) {
+        if (++spins >= SPIN_LIMIT) {
+            spins = 0;
+            std::this_thread::yield();
+        }
+    }
+
+    static void lockShared(Shard &s) {
+        int spins = 0;
+        while (true) {
+            std::uint32_t cur = s.state.load(std::memory_order_relaxed);
+            if (!(cur & WRITER)
+                && s.state.compare_exchange_weak(cur, cur + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                return;
+            }
+            backoff(spins);
+        }
+    }
+
+    static void unlockShared(Shard &s) {
+        s.state.fetch_sub(1, std::memory_order_release);
+    }
+
+    /*
+    Take the lock exclusively. The writer bit is set first, which keeps
+    new readers out, and then the readers holding the lock are waited for.
+    */
+    static void lock(Shard &s) {
+        int spins = 0;
+        while (true) {
+            std::uint32_t cur = s.state.load(std::memory_order_relaxed);
+            if (!(cur & WRITER)
+                && s.state.compare_exchange_weak(cur, cur | WRITER, std::memory_order_relaxed,
+                                                 std::memory_order_relaxed)) {
+                break;
+            }
+            backoff(spins);
+        }
+        while (s.state.load(std::memory_order_acquire) != WRITER) {
+            backoff(spins);
+        }
+    }
+
+    static void unlock(Shard &s) {
+        s.size.store(s.table.getSize(), std::memory_order_relaxed);
+        s.state.store(0, std::memory_order_release);
+    }
+
+    /*
+    Hold the lock of a shard in shared mode until the end of the scope,
+    so that an exception thrown by the values or the functors cannot
+    leave the shard locked.
+    */
+    struct ReadGuard {
+        Shard &s;
+
+        explicit ReadGuard(Shard &s_) : s(s_) {
+            lockShared(s);
+        }
+
+        ~ReadGuard() {
+            unlockShared(s);
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard& operator=(const ReadGuard &) = delete;
+    };
+
+    /*
+    Hold the lock of a shard exclusively until the end of the scope.
+    */
+    struct WriteGuard {
+        Shard &s;
+
+        explicit WriteGuard(Shard &s_) : s(s_) {
+            lock(s);
+        }
+
+        ~WriteGuard() {
+            unlock(s);
+        }
+
+        WriteGuard(const WriteGuard &) = delete;
+        WriteGuard& operator=(const WriteGuard &) = delete;
+    };
+
+    template<typename V>
+    bool emplace(V &&val) {
+        const SizeType h = hash(val);
+        Shard &s = shardOf(h);
+        WriteGuard guard(s);
+        const bool absent = s.table.findIndex(val, h) == Table::NPOS;
+        if (absent) {
+            const SizeType i = s.table.prepareInsert(h);
+            new (&s.table.slot(i)) Value(std::forward<V>(val));
+            s.table.commit(i, h);
+        }
+        return absent;
+    }
+};
+
+template<typename Value, typename Pred, typename Hash>
+const typename ConcurrentHashTable<Value, Pred, Hash>::SizeType ConcurrentHashTable<Value, Pred, Hash>::CACHE_LINE;
+
+template<typename Value, typename Pred, typename Hash>
+const std::uint32_t ConcurrentHashTable<Value, Pred, Hash>::WRITER;
+
+template<typename Value, typename Pred, typename Hash>
+const int ConcurrentHashTable<Value, Pred, Hash>::SPIN_LIMIT;
+
+TASTYLIB_NS_END
+
+#endif
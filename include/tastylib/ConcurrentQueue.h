@@ -0,0 +1,214 @@
+#ifndef TASTYLIB_CONCURRENTQUEUE_H_
+#define TASTYLIB_CONCURRENTQUEUE_H_
+
+#include "tastylib/internal/base.h"
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <new>
+#include <utility>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A bounded lock-free FIFO queue for multiple producer and consumer
+threads. Values live in a ring buffer of cells, and each cell carries
+a sequence number telling whether it is ready to be written or read.
+A thread claims a cell with a single compare-and-swap on the enqueue
+or dequeue position, so no thread ever waits for a lock. Values are
+copied into the queue, the same as DoublyLinkedList, and moved out.
+
+@param Value The type of queue value.
+*/
+template<typename Value>
+class ConcurrentQueue {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Initialize an empty queue.
+
+    @param capacity The maximum amount of values in the queue. It is
+                    rounded up to a power of 2 and is at least 2.
+    */
+    explicit ConcurrentQueue(const SizeType capacity = 1024)
+        : ring(), enqueue(), dequeue() {
+        SizeType cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        ring.cells = new Cell[cap];
+        for (SizeType i = 0; i < cap; ++i) {
+            ring.cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        ring.mask = cap - 1;
+        enqueue.pos.store(0, std::memory_order_relaxed);
+        dequeue.pos.store(0, std::memory_order_relaxed);
+    }
+
+    /*
+    Destructor. It must not run concurrently with other operations.
+    */
+    ~ConcurrentQueue() {
+        SizeType enq = enqueue.pos.load(std::memory_order_relaxed);
+        for (SizeType pos = dequeue.pos.load(std::memory_order_relaxed); pos != enq; ++pos) {
+            ring.cells[pos & ring.mask].ptr()->~Value();
+        }
+        delete[] ring.cells;
+    }
+
+    ConcurrentQueue(const ConcurrentQueue &) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue &) = delete;
+
+    /*
+    Return the maximum amount of values in the queue.
+    */
+    SizeType getCapacity() const {
+        return ring.mask + 1;
+    }
+
+    /*
+    Return the amount of values in the queue. The result
+    is approximate while other threads modify the queue.
+    */
+    SizeType getSize() const {
+        SizeType deq = dequeue.pos.load(std::memory_order_relaxed);
+        SizeType enq = enqueue.pos.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+
+    /*
+    Return true if the queue is empty. The result is
+    approximate while other threads modify the queue.
+    */
+    bool isEmpty() const {
+        return getSize() == 0;
+    }
+
+    /*
+    Push a value to the back of the queue if the queue is not full.
+
+    @param val The value to be pushed
+    @return    True if the value is pushed, false if the queue is full.
+    */
+    bool tryPush(const Value &val) {
+        Cell *cell;
+        SizeType pos = enqueue.pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &ring.cells[pos & ring.mask];
+            SizeType seq = cell->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+            if (diff == 0) {  // The cell is free
+                if (enqueue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {  // The cell still holds a value from the last lap
+                return false;
+            } else {  // Another producer has claimed the cell
+                pos = enqueue.pos.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->ptr()) Value(val);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    Pop the value at the front of the queue if the queue is not empty.
+
+    @param val Output. The popped value.
+    @return    True if a value is popped, false if the queue is empty.
+    */
+    bool tryPop(Value &val) {
+        Cell *cell;
+        SizeType pos = dequeue.pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &ring.cells[pos & ring.mask];
+            SizeType seq = cell->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0) {  // The cell holds a value
+                if (dequeue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {  // The cell has not been written yet
+                return false;
+            } else {  // Another consumer has claimed the cell
+                pos = dequeue.pos.load(std::memory_order_relaxed);
+            }
+        }
+        Value *v = cell->ptr();
+        val = std::move(*v);
+        v->~Value();
+        cell->seq.store(pos + ring.mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    Push a value to the back of the queue. If the queue
+    is full, wait until another thread pops a value.
+
+    @param val The value to be pushed
+    */
+    void push(const Value &val) {
+        while (!tryPush(val)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /*
+    Pop the value at the front of the queue. If the queue
+    is empty, wait until another thread pushes a value.
+
+    @param val Output. The popped value.
+    */
+    void pop(Value &val) {
+        while (!tryPop(val)) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    /*
+    Size of a cache line. Members written by different
+    threads are padded to different cache lines.
+    */
+    static const SizeType CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<SizeType> seq;
+        typename std::aligned_storage<sizeof(Value), alignof(Value)>::type data;
+
+        Value* ptr() {
+            return reinterpret_cast<Value*>(&data);
+        }
+    };
+
+    /*
+    A position counter that fills a cache line by itself.
+    */
+    struct Cursor {
+        std::atomic<SizeType> pos;
+        char pad[CACHE_LINE - sizeof(std::atomic<SizeType>)];
+    };
+
+    /*
+    The cells and the mask are only read after construction.
+    The padding keeps them away from the cursors.
+    */
+    struct Ring {
+        Cell *cells;
+        SizeType mask;
+        char pad[CACHE_LINE - sizeof(Cell*) - sizeof(SizeType)];
+    };
+
+    Ring ring;
+    Cursor enqueue;
+    Cursor dequeue;
+};
+
+template<typename Value>
+const typename ConcurrentQueue<Value>::SizeType ConcurrentQueue<Value>::CACHE_LINE;
+
+TASTYLIB_NS_END
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "tastylib/internal/base.h"
 #include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 TASTYLIB_NS_BEGIN
 
@@ -28,6 +31,85 @@ public:
 
     typedef std::size_t SizeType;
 
+    /*
+    Bidirectional iterator of the list. Decrementing the
+    end iterator moves it to the last node of the list.
+
+    @param Ref The reference type of the node value
+    @param Ptr The pointer type of the node value
+    */
+    template<typename Ref, typename Ptr>
+    class IteratorImpl {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+
+        IteratorImpl() : node(nullptr), list(nullptr) {}
+
+        /*
+        Copy constructor. It also converts a mutable
+        iterator to a constant one.
+        */
+        IteratorImpl(const IteratorImpl<Value&, Value*> &it)
+            : node(it.node), list(it.list) {}
+
+        IteratorImpl& operator=(const IteratorImpl &it) = default;
+
+        Ref operator*() const {
+            return node->val;
+        }
+
+        Ptr operator->() const {
+            return &node->val;
+        }
+
+        IteratorImpl& operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp(*this);
+            node = node->next;
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            node = (node ? node->prev : list->tail);
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp(*this);
+            node = (node ? node->prev : list->tail);
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl &it) const {
+            return node == it.node;
+        }
+
+        bool operator!=(const IteratorImpl &it) const {
+            return node != it.node;
+        }
+
+    private:
+        friend class DoublyLinkedList;
+        template<typename, typename> friend class IteratorImpl;
+
+        Node *node;
+        const DoublyLinkedList *list;
+
+        IteratorImpl(Node *n, const DoublyLinkedList *l)
+            : node(n), list(l) {}
+    };
+
+    typedef IteratorImpl<Value&, Value*> Iterator;
+    typedef IteratorImpl<const Value&, const Value*> ConstIterator;
+
     /*
     Destructor.
     */
@@ -69,6 +151,28 @@ public:
         size = 0;
     }
 
+    /*
+    Return an iterator to the first node of the list.
+    */
+    Iterator begin() {
+        return Iterator(head, this);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(head, this);
+    }
+
+    /*
+    Return an iterator to the position past the last node of the list.
+    */
+    Iterator end() {
+        return Iterator(nullptr, this);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr, this);
+    }
+
     /*
     Traverse the list node.
 
@@ -102,6 +206,31 @@ public:
         return -1;
     }
 
+    /*
+    Find the first node whose value satisfies a predicate.
+
+    @param f A unary predicate that accepts a node value
+    @return  The iterator to the first matching node. If no
+             node matches, return end().
+    */
+    template<typename UnaryPred>
+    Iterator findIf(const UnaryPred &f) {
+        Node *tmp = head;
+        while (tmp && !f(tmp->val)) {
+            tmp = tmp->next;
+        }
+        return Iterator(tmp, this);
+    }
+
+    template<typename UnaryPred>
+    ConstIterator findIf(const UnaryPred &f) const {
+        Node *tmp = head;
+        while (tmp && !f(tmp->val)) {
+            tmp = tmp->next;
+        }
+        return ConstIterator(tmp, this);
+    }
+
     /*
     Insert a node at a given position. If the position is greater than
     the list's size, the node will be inserted to the back of the list.
@@ -138,6 +267,22 @@ public:
         }
     }
 
+    /*
+    Insert a node before the node that an iterator points to.
+    Unlike insert(SizeType, const Value&), this function does
+    not walk the list.
+
+    @param pos The iterator before which the node is inserted
+    @param val The value of the node to be inserted
+    @return    The iterator to the inserted node
+    */
+    Iterator insert(ConstIterator pos, const Value &val) {
+        Node *newNode = new Node(val);
+        link(pos.node, newNode);
+        ++size;
+        return Iterator(newNode, this);
+    }
+
     /*
     Insert a node at the front of the list.
 
@@ -206,6 +351,132 @@ public:
         }
     }
 
+    /*
+    Remove the node that an iterator points to. The iterator
+    becomes invalid after its execution.
+    Precondition: The iterator points to a node of the list.
+
+    @param pos The iterator to the node to be removed
+    @return    The iterator to the node next to the removed one
+    */
+    Iterator erase(ConstIterator pos) {
+        Node *del = pos.node, *next = del->next;
+        unlink(del);
+        --size;
+        delete del;
+        return Iterator(next, this);
+    }
+
+    /*
+    Remove the nodes in the range [first, last).
+
+    @param first The iterator to the first node to be removed
+    @param last  The iterator past the last node to be removed
+    @return      The iterator 'last'
+    */
+    Iterator erase(ConstIterator first, ConstIterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return Iterator(last.node, this);
+    }
+
+    /*
+    Move all nodes of another list before the node that an iterator
+    points to. No node is copied or reallocated, and the other list
+    becomes empty.
+
+    @param pos   The iterator before which the nodes are inserted
+    @param other The list whose nodes are moved
+    */
+    void splice(ConstIterator pos, DoublyLinkedList &other) {
+        if (&other == this || other.isEmpty()) {
+            return;
+        }
+        Node *first = other.head, *last = other.tail;
+        first->prev = (pos.node ? pos.node->prev : tail);
+        last->next = pos.node;
+        if (first->prev) {
+            first->prev->next = first;
+        } else {
+            head = first;
+        }
+        if (pos.node) {
+            pos.node->prev = last;
+        } else {
+            tail = last;
+        }
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /*
+    Move one node of a list(which may be this list) before the
+    node that an iterator points to. No node is copied or reallocated.
+
+    @param pos   The iterator before which the node is inserted
+    @param other The list that owns the node to be moved
+    @param it    The iterator to the node to be moved
+    */
+    void splice(ConstIterator pos, DoublyLinkedList &other, ConstIterator it) {
+        Node *n = it.node;
+        if (&other == this && (n == pos.node || n->next == pos.node)) {
+            return;  // Already in place
+        }
+        other.unlink(n);
+        --other.size;
+        link(pos.node, n);
+        ++size;
+    }
+
+    /*
+    Merge another sorted list into this sorted list by relinking
+    nodes. The merge is stable and the other list becomes empty.
+
+    @param other The list to be merged
+    */
+    void merge(DoublyLinkedList &other) {
+        merge(other, std::less<Value>());
+    }
+
+    /*
+    Merge another sorted list into this sorted list in custom order.
+    Both lists must be sorted with the same comparator.
+
+    @param other The list to be merged
+    @param cmp   A binary predicate to compare two node values
+    */
+    template<typename Comparator>
+    void merge(DoublyLinkedList &other, const Comparator &cmp) {
+        if (&other == this || other.isEmpty()) {
+            return;
+        }
+        Node *cur = head, *n = other.head;
+        while (n) {
+            if (!cur) {  // Append the rest of the other list
+                n->prev = tail;
+                if (tail) {
+                    tail->next = n;
+                } else {
+                    head = n;
+                }
+                tail = other.tail;
+                break;
+            }
+            if (cmp(n->val, cur->val)) {
+                Node *next = n->next;
+                link(cur, n);
+                n = next;
+            } else {
+                cur = cur->next;
+            }
+        }
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
     /*
     Remove the first node of the list.
     */
@@ -248,7 +519,10 @@ public:
     }
 
     /*
-    Sort the list nodes in custom order.
+    Sort the list nodes in custom order. The sort is stable. It merges
+    the natural ascending and descending runs of the list bottom-up, so
+    a list that is nearly sorted in either order is sorted in close to
+    linear time.
 
     @param cmp A binary predicate to compare two node values. The sorting
                algorithm ensures that after its execution, for each node A
@@ -257,7 +531,88 @@ public:
     */
     template<typename Comparator>
     void sort(const Comparator &cmp) {
-        head = mergeSort(head, size, cmp);
+        if (size > 1) {
+            Run run = sortChain(head, cmp);
+            head = run.head;
+            tail = run.tail;
+            head->prev = nullptr;
+        }
+    }
+
+    /*
+    Sort the list nodes in custom order with multiple threads. The sort
+    is stable. The list is cut into contiguous segments which are sorted
+    concurrently, and then adjacent sorted segments are merged in pairs
+    concurrently until one segment is left. Nodes are relinked and never
+    copied.
+
+    @param cmp       A binary predicate to compare two node values. It must
+                     be safe to call from several threads at the same time.
+    @param threadNum The maximum amount of threads to use, including the
+                     calling thread. If it is less than 2 or the list is
+                     too short, the list is sorted by the calling thread.
+    */
+    template<typename Comparator>
+    void sort(const Comparator &cmp, SizeType threadNum) {
+        SizeType segNum = size / MIN_PARALLEL_SEGMENT;
+        segNum = (threadNum < segNum ? threadNum : segNum);
+        if (segNum < 2) {
+            sort(cmp);
+            return;
+        }
+
+        // Cut the list into segments of nearly equal lengths
+        std::vector<Run> segs(segNum);
+        Node *cur = head;
+        for (SizeType i = 0; i < segNum; ++i) {
+            SizeType len = size / segNum + (i < size % segNum ? 1 : 0);
+            segs[i].head = cur;
+            segs[i].len = len;
+            for (SizeType j = 1; j < len; ++j) {
+                cur = cur->next;
+            }
+            segs[i].tail = cur;
+            cur = cur->next;
+            segs[i].tail->next = nullptr;
+        }
+
+        // Sort the segments
+        std::vector<std::thread> threads;
+        threads.reserve(segNum - 1);
+        for (SizeType i = 1; i < segNum; ++i) {
+            threads.emplace_back([&segs, &cmp, i]() {
+                segs[i] = sortChain(segs[i].head, cmp);
+            });
+        }
+        segs[0] = sortChain(segs[0].head, cmp);
+        for (auto &t : threads) {
+            t.join();
+        }
+
+        // Merge adjacent segments in pairs until one segment is left
+        while (segNum > 1) {
+            SizeType pairNum = segNum / 2;
+            threads.clear();
+            for (SizeType i = 1; i < pairNum; ++i) {
+                threads.emplace_back([&segs, &cmp, i]() {
+                    segs[2 * i] = mergeRuns(segs[2 * i], segs[2 * i + 1], cmp);
+                });
+            }
+            segs[0] = mergeRuns(segs[0], segs[1], cmp);
+            for (auto &t : threads) {
+                t.join();
+            }
+            for (SizeType i = 1; i < pairNum; ++i) {
+                segs[i] = segs[2 * i];
+            }
+            if (segNum % 2) {
+                segs[pairNum] = segs[segNum - 1];
+            }
+            segNum = (segNum + 1) / 2;
+        }
+        head = segs[0].head;
+        tail = segs[0].tail;
+        head->prev = nullptr;
     }
 
 private:
@@ -265,6 +620,47 @@ private:
     Node *head;
     Node *tail;
 
+    /*
+    Link a detached node before a given node. The size of the list is not changed.
+
+    @param pos The node before which the node is linked. If it is
+               null, the node is linked to the back of the list.
+    @param n   The node to be linked
+    */
+    void link(Node *pos, Node *n) {
+        n->next = pos;
+        n->prev = (pos ? pos->prev : tail);
+        if (n->prev) {
+            n->prev->next = n;
+        } else {
+            head = n;
+        }
+        if (pos) {
+            pos->prev = n;
+        } else {
+            tail = n;
+        }
+    }
+
+    /*
+    Detach a node from the list without freeing it.
+    The size of the list is not changed.
+
+    @param n The node to be detached
+    */
+    void unlink(Node *n) {
+        if (n->prev) {
+            n->prev->next = n->next;
+        } else {
+            head = n->next;
+        }
+        if (n->next) {
+            n->next->prev = n->prev;
+        } else {
+            tail = n->prev;
+        }
+    }
+
     /*
     Get a best node to perform inserting operation at a given position.
     The function is available only when the list is not empty.
@@ -295,66 +691,217 @@ private:
     }
 
     /*
-    Running a merge sort procedure of the list.
+    A sorted run of nodes. The 'next' pointer of the tail node is null,
+    and the 'prev' pointer of the head node is not maintained.
+    */
+    struct Run {
+        Node *head;
+        Node *tail;
+        SizeType len;
+    };
 
-    @param h     The head of the list
-    @param size_ The size of the list
-    @param cmp   A binary predicate to compare two node values
-    @return      The head pointer of the sorted list
+    /*
+    The maximum amount of pending runs while sorting. The lengths of the
+    pending runs grow at least as fast as the Fibonacci numbers, which
+    is far less than this value for any list that fits in memory.
     */
-    template<typename Comparator>
-    Node* mergeSort(Node *h, const SizeType size_, const Comparator &cmp) {
-        if (size_ < 2) {
-            return h;
-        }
+    static const SizeType MAX_RUNS = 128;
 
-        // Find middle position
-        Node *mid = h;
-        SizeType size1 = size_ >> 1, size2 = size_ - size1;
-        for (SizeType i = 0; i < size1 - 1; ++i) {
-            mid = mid->next;
-        }
+    /*
+    Runs shorter than this value are extended by insertion sort.
+    */
+    static const SizeType MIN_RUN = 4;
 
-        // Sort each half of the list
-        Node *h2 = mergeSort(mid->next, size2, cmp);
-        Node *h1 = mergeSort(h, size1, cmp);
+    /*
+    The minimum amount of nodes in a segment that is sorted by its own
+    thread. Shorter segments are not worth the cost of starting a thread.
+    */
+    static const SizeType MIN_PARALLEL_SEGMENT = 8192;
 
-        // Merge h1 and h2(they are both sorted and non-empty)
-        SizeType cnt = 0;
-        Node *newHead = h1;
-        for (bool initLoop = true; ; initLoop = false) {
-            if (cmp(h2->val, h1->val)) {
-                if (initLoop) {
-                    newHead = h2;
-                }
-                Node *h2Prev = h2->prev, *h2Next = h2->next, *h1Prev = h1->prev;
-                h2Prev->next = h2Next;
-                if (h2Next) {
-                    h2Next->prev = h2->prev;
-                } else {  // New tail
-                    tail = h2Prev;
-                }
-                if (h1Prev) {
-                    h1Prev->next = h2;
-                }
-                h2->prev = h1Prev;
-                h2->next = h1;
-                h1->prev = h2;
-                h2 = h2Next;
-                if (++cnt == size2) {
+    /*
+    Sort a chain of doubly linked nodes. The 'prev' pointers are
+    relinked along the way, so no extra pass is needed to fix them.
+
+    @param h   The head of the chain. The chain ends with a null pointer.
+    @param cmp A binary predicate to compare two node values
+    @return    The sorted chain
+    */
+    template<typename Comparator>
+    static Run sortChain(Node *h, const Comparator &cmp) {
+        // Pending runs on a stack. The lengths of the runs satisfy:
+        // 1. runs[i - 2].len > runs[i - 1].len + runs[i].len
+        // 2. runs[i - 1].len > runs[i].len
+        Run runs[MAX_RUNS];
+        SizeType n = 0;
+        while (h) {
+            runs[n++] = nextRun(h, cmp);
+            while (n > 1) {
+                SizeType k = n - 2;
+                if ((k > 0 && runs[k - 1].len <= runs[k].len + runs[k + 1].len)
+                    || (k > 1 && runs[k - 2].len <= runs[k - 1].len + runs[k].len)) {
+                    if (runs[k - 1].len < runs[k + 1].len) {
+                        --k;
+                    }
+                } else if (runs[k].len > runs[k + 1].len) {
                     break;
                 }
+                mergeAt(runs, n, k, cmp);
+            }
+        }
+        while (n > 1) {
+            SizeType k = n - 2;
+            if (k > 0 && runs[k - 1].len < runs[k + 1].len) {
+                --k;
+            }
+            mergeAt(runs, n, k, cmp);
+        }
+        return runs[0];
+    }
+
+    /*
+    Detach the longest run at the head of a chain. A strictly descending
+    run is reversed, which keeps the sort stable.
+
+    @param h   The head of the chain. It is moved past the detached run.
+    @param cmp A binary predicate to compare two node values
+    @return    The detached run in sorted order
+    */
+    template<typename Comparator>
+    static Run nextRun(Node *&h, const Comparator &cmp) {
+        Node *first = h, *cur = h->next;
+        Run run = {first, first, 1};
+        if (cur && cmp(cur->val, first->val)) {  // Descending
+            first->next = nullptr;
+            while (cur && cmp(cur->val, run.head->val)) {
+                Node *next = cur->next;
+                cur->next = run.head;
+                run.head->prev = cur;
+                run.head = cur;
+                cur = next;
+                ++run.len;
+            }
+        } else {  // Ascending
+            while (cur && !cmp(cur->val, run.tail->val)) {
+                run.tail = cur;
+                cur = cur->next;
+                ++run.len;
+            }
+            run.tail->next = nullptr;
+        }
+        // Extend a short run by insertion sort
+        while (cur && run.len < MIN_RUN) {
+            Node *next = cur->next, *q = run.head, *p = nullptr;
+            while (q && !cmp(cur->val, q->val)) {
+                p = q;
+                q = q->next;
+            }
+            if (!p) {
+                cur->next = run.head;
+                run.head->prev = cur;
+                run.head = cur;
             } else {
-                h1 = h1->next;
-                if (h1 == h2) {
-                    break;
+                cur->next = q;
+                cur->prev = p;
+                p->next = cur;
+                if (q) {
+                    q->prev = cur;
+                } else {
+                    run.tail = cur;
                 }
             }
+            cur = next;
+            ++run.len;
         }
-        return newHead;
+        h = cur;
+        return run;
+    }
+
+    /*
+    Merge the adjacent pending runs runs[k] and runs[k + 1].
+
+    @param runs The stack of the pending runs
+    @param n    The amount of the pending runs, which is decreased by one
+    @param k    The index of the first run to merge
+    @param cmp  A binary predicate to compare two node values
+    */
+    template<typename Comparator>
+    static void mergeAt(Run *runs, SizeType &n, const SizeType k, const Comparator &cmp) {
+        runs[k] = mergeRuns(runs[k], runs[k + 1], cmp);
+        if (k + 3 == n) {
+            runs[k + 1] = runs[k + 2];
+        }
+        --n;
+    }
+
+    /*
+    Merge two sorted runs stably. The nodes of run 'a' come first
+    when two node values are equal.
+
+    @param a   The first run
+    @param b   The second run
+    @param cmp A binary predicate to compare two node values
+    @return    The merged run
+    */
+    template<typename Comparator>
+    static Run mergeRuns(const Run &a, const Run &b, const Comparator &cmp) {
+        Run res = {a.head, b.tail, a.len + b.len};
+        if (!cmp(b.head->val, a.tail->val)) {  // Already in order
+            a.tail->next = b.head;
+            b.head->prev = a.tail;
+            return res;
+        }
+        if (cmp(b.tail->val, a.head->val)) {  // Run 'b' goes entirely first
+            b.tail->next = a.head;
+            a.head->prev = b.tail;
+            res.head = b.head;
+            res.tail = a.tail;
+            return res;
+        }
+        Node *x = a.head, *y = b.head, *last;
+        if (cmp(y->val, x->val)) {
+            res.head = last = y;
+            y = y->next;
+        } else {
+            last = x;
+            x = x->next;
+        }
+        while (x && y) {
+            if (cmp(y->val, x->val)) {
+                last->next = y;
+                y->prev = last;
+                last = y;
+                y = y->next;
+            } else {
+                last->next = x;
+                x->prev = last;
+                last = x;
+                x = x->next;
+            }
+        }
+        if (x) {  // The rest of run 'a' is still linked
+            last->next = x;
+            x->prev = last;
+            res.tail = a.tail;
+        } else {
+            last->next = y;
+            y->prev = last;
+        }
+        return res;
     }
 };
 
+template<typename Value, typename Pred>
+const typename DoublyLinkedList<Value, Pred>::SizeType
+DoublyLinkedList<Value, Pred>::MAX_RUNS;
+
+template<typename Value, typename Pred>
+const typename DoublyLinkedList<Value, Pred>::SizeType
+DoublyLinkedList<Value, Pred>::MIN_RUN;
+
+template<typename Value, typename Pred>
+const typename DoublyLinkedList<Value, Pred>::SizeType
+DoublyLinkedList<Value, Pred>::MIN_PARALLEL_SEGMENT;
+
 TASTYLIB_NS_END
 
 #endif
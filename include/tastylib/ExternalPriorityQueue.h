@@ -0,0 +1,460 @@
+#ifndef TASTYLIB_EXTERNALPRIORITYQUEUE_H_
+#define TASTYLIB_EXTERNALPRIORITYQUEUE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/BinaryHeap.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A priority queue whose elements may outgrow the memory. It keeps at most
+a given amount of memory for the elements, and the rest are stored in
+temporary files.
+
+New elements go to an insertion buffer, which is a BinaryHeap of bounded
+size. When the buffer is full, its elements are written to a temporary
+file as a sorted run. Each run is read back one block at a time, and the
+fronts of the runs are merged lazily by another BinaryHeap, so the root
+of the queue is the better one of the buffer root and the best run front.
+When the amount of runs reaches the limit of the memory for their blocks,
+the smaller half of the runs are merged into one run.
+
+Half of the memory budget is for the insertion buffer, and the other half
+is for the blocks of the runs, one block for writing, and the first block
+of a new run, which is kept in memory when it is written.
+
+I/O errors lose no elements. A failed write leaves the elements where they
+were, and a failed read leaves the run as it was, so the operation can be
+retried.
+
+@param Value The type of the value stored in the queue, which is written
+             to the files as raw bytes and must be trivially copyable
+@param Pred  The type of the binary predicate like that of BinaryHeap.
+             By default it uses operator '>=', which makes it a min-root queue.
+*/
+template<typename Value, typename Pred = std::greater_equal<Value>>
+class ExternalPriorityQueue {
+public:
+    static_assert(std::is_trivially_copyable<Value>::value,
+                  "The value of ExternalPriorityQueue must be trivially copyable.");
+
+    typedef typename BinaryHeap<Value, Pred>::SizeType SizeType;
+    typedef std::function<std::FILE*()> FileOpener;
+
+    /*
+    Destructor. The temporary files are closed.
+    */
+    ~ExternalPriorityQueue() {
+        clear();
+    }
+
+    /*
+    Initialize the queue.
+
+    @param memoryBytes The memory budget of the elements in bytes
+    @param blockBytes  The size of a block read from or written to
+                       the files in bytes
+    @param openFile    The function that opens an empty file for a run in
+                       "w+b" mode. By default it is std::tmpfile(), whose
+                       files are removed when they are closed.
+    */
+    explicit ExternalPriorityQueue(const SizeType memoryBytes, const SizeType blockBytes = 1 << 16,
+                                   const FileOpener &openFile_ = std::tmpfile)
+        : size(0), openFile(openFile_) {
+        bufferCap = std::max<SizeType>(1, memoryBytes / 2 / sizeof(Value));
+        blockLen = std::max<SizeType>(1, blockBytes / sizeof(Value));
+        const SizeType blocks = memoryBytes / 2 / (blockLen * sizeof(Value));
+        // One block is for writing, and one is for the first block of a new run
+        maxRuns = (blocks > 4 ? blocks - 2 : 2);
+    }
+
+    ExternalPriorityQueue(const ExternalPriorityQueue &) = delete;
+    ExternalPriorityQueue& operator=(const ExternalPriorityQueue &) = delete;
+
+    /*
+    Return the amount of elements in the queue.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the queue has no elements.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Return the amount of sorted runs in the temporary files.
+    */
+    SizeType getRunCount() const {
+        return runs.size();
+    }
+
+    /*
+    Return the maximum amount of elements in the insertion buffer.
+    */
+    SizeType getBufferCapacity() const {
+        return bufferCap;
+    }
+
+    /*
+    Remove all elements, and close the temporary files.
+    */
+    void clear() {
+        for (Run *run : runs) {
+            std::fclose(run->file);
+            delete run;
+        }
+        runs.clear();
+        runHeap.clear();
+        buffer.clear();
+        size = 0;
+    }
+
+    /*
+    Insert a new element to the queue. If the insertion buffer is full,
+    it is written to a temporary file first.
+
+    @param val The value of the element to be inserted
+    @return    False if the buffer cannot be written to a file,
+               and the element is not inserted.
+    */
+    bool push(const Value &val) {
+        if (buffer.getSize() >= bufferCap && !spill()) {
+            return false;
+        }
+        buffer.push(val);
+        ++size;
+        return true;
+    }
+
+    /*
+    Return the root element of the queue.
+    Precondition: The queue is non-empty.
+    */
+    const Value& top() const {
+        return topInBuffer() ? buffer.top() : runHeap.top()->front();
+    }
+
+    /*
+    Remove the root element of the queue.
+    Precondition: The queue is non-empty.
+
+    @return False if the next block of a run cannot be read from its
+            file. The queue is unchanged then, and pop() can be retried.
+    */
+    bool pop() {
+        if (topInBuffer()) {
+            buffer.pop();
+            --size;
+            return true;
+        }
+        Run *run = runHeap.top();
+        if (!advance(run)) {
+            return false;
+        }
+        --size;
+        if (run->block.empty()) {
+            runHeap.pop();
+            removeRun(run);
+        } else {
+            runHeap.replaceTop(run);
+        }
+        return true;
+    }
+
+    /*
+    Remove the root element of the queue and return it.
+    Precondition: The queue is non-empty.
+
+    @param val Output. The root element.
+    @return    False if the root cannot be removed as in pop(),
+               and 'val' is not changed then.
+    */
+    bool popTop(Value &val) {
+        const Value res(top());
+        if (!pop()) {
+            return false;
+        }
+        val = res;
+        return true;
+    }
+
+private:
+    /*
+    A sorted run in a temporary file. The elements of its first block
+    are kept in memory when the file is written, and the others are
+    read from the file one block at a time.
+    */
+    struct Run {
+        std::FILE *file;
+        std::vector<Value> block;  // The elements read from the file
+        SizeType pos;              // The position of the front in the block
+        SizeType next;             // The index in the file of the first element not read yet
+        SizeType unread;           // The amount of elements not read yet
+        bool seekNeeded;           // True if the file position may not be at 'next'
+
+        explicit Run(std::FILE *file_)
+            : file(file_), pos(0), next(0), unread(0), seekNeeded(true) {}
+
+        const Value& front() const {
+            return block[pos];
+        }
+    };
+
+    /*
+    The front of a run and the position after it in the file, which
+    are enough to restore the run when a merge fails.
+    */
+    struct RunState {
+        Run *run;
+        Value front;
+        SizeType next;    // The index in the file of the element after the front
+        SizeType unread;  // The amount of elements after the front
+    };
+
+    struct RunPred {
+        bool operator()(const Run *a, const Run *b) const {
+            return Pred()(a->front(), b->front());
+        }
+    };
+
+    SizeType bufferCap;  // Maximum amount of elements in the buffer
+    SizeType blockLen;   // Amount of elements in a block
+    SizeType maxRuns;    // Maximum amount of runs
+    SizeType size;
+    Pred pred;
+    FileOpener openFile;
+    BinaryHeap<Value, Pred> buffer;
+    BinaryHeap<Run*, RunPred> runHeap;  // The runs ordered by their fronts
+    std::vector<Run*> runs;
+    std::vector<Value> outBlock;
+
+    /*
+    Return true if the root of the queue is in the buffer.
+    Precondition: The queue is non-empty.
+    */
+    bool topInBuffer() const {
+        return runHeap.isEmpty() || (!buffer.isEmpty() && pred(runHeap.top()->front(), buffer.top()));
+    }
+
+    /*
+    Move to the next element of a run, and read the next block from the
+    file if the current block is used up. If the run has no more elements,
+    its block becomes empty.
+
+    @return False if the next block cannot be read. The front of the run
+            is unchanged then, so that it can be retried.
+    */
+    bool advance(Run *run) {
+        std::vector<Value> &block = run->block;
+        if (run->pos + 1 < block.size()) {
+            ++run->pos;
+            return true;
+        }
+        const SizeType n = std::min(run->unread, blockLen);
+        if (n == 0) {
+            block.clear();
+            run->pos = 0;
+            return true;
+        }
+        // Keep the front after the new elements until the read succeeds
+        if (block.size() < n + 1) {
+            block.resize(n + 1);
+        }
+        block[n] = block[run->pos];
+        if ((run->seekNeeded
+             && std::fseek(run->file, (long)(run->next * sizeof(Value)), SEEK_SET) != 0)
+            || std::fread(block.data(), sizeof(Value), n, run->file) < n) {
+            std::clearerr(run->file);
+            run->seekNeeded = true;
+            block[0] = block[n];
+            block.resize(1);
+            run->pos = 0;
+            return false;
+        }
+        run->seekNeeded = false;
+        block.resize(n);
+        run->pos = 0;
+        run->next += n;
+        run->unread -= n;
+        return true;
+    }
+
+    /*
+    Open the file of a new run. The file is not buffered, because the
+    blocks are written and read as a whole, and then a write error is
+    reported by fwrite() instead of a later flush.
+    */
+    std::FILE* openRunFile() {
+        std::FILE *file = openFile();
+        if (file) {
+            std::setvbuf(file, nullptr, _IONBF, 0);
+        }
+        return file;
+    }
+
+    void removeRun(Run *run) {
+        std::fclose(run->file);
+        runs.erase(std::find(runs.begin(), runs.end(), run));
+        delete run;
+    }
+
+    /*
+    Write the elements in the output block after the first 'len' elements
+    of a new run. The first block written is also kept as the block of the
+    run. The output block is cleared if it is written.
+
+    @return False if the elements are not all written, and
+            they are not counted in 'len' then.
+    */
+    bool flush(Run *out, SizeType &len) {
+        const SizeType n = outBlock.size();
+        if (std::fwrite(outBlock.data(), sizeof(Value), n, out->file) < n) {
+            std::clearerr(out->file);
+            return false;
+        }
+        if (len == 0) {
+            out->block.reserve(blockLen + 1);
+            out->block.assign(outBlock.begin(), outBlock.end());
+        }
+        len += n;
+        outBlock.clear();
+        return true;
+    }
+
+    /*
+    Start reading a run of 'len' elements whose file
+    has been written, and add it to the runs.
+    */
+    void addRun(Run *run, const SizeType len) {
+        run->pos = 0;
+        run->next = run->block.size();
+        run->unread = len - run->block.size();
+        run->seekNeeded = true;
+        runs.push_back(run);
+        runHeap.push(run);
+    }
+
+    /*
+    Write the elements in the buffer to a new run. The elements
+    that cannot be written stay in the buffer.
+
+    @return False if the buffer is still full.
+    */
+    bool spill() {
+        if (runs.size() >= maxRuns && !mergeRuns()) {
+            return false;
+        }
+        std::FILE *file = openRunFile();
+        if (!file) {
+            return false;
+        }
+        Run *run = new Run(file);
+        SizeType len = 0;
+        outBlock.reserve(blockLen);
+        while (!buffer.isEmpty()) {
+            outBlock.push_back(buffer.popTop());
+            if ((outBlock.size() == blockLen || buffer.isEmpty()) && !flush(run, len)) {
+                for (const auto &val : outBlock) {
+                    buffer.push(val);
+                }
+                outBlock.clear();
+                break;
+            }
+        }
+        if (len == 0) {
+            std::fclose(file);
+            delete run;
+            return false;
+        }
+        addRun(run, len);
+        return buffer.getSize() < bufferCap;
+    }
+
+    /*
+    Merge the smaller half of the runs into one run. The merged runs are
+    removed only when the merge is finished, so if a write or a read
+    fails, the new run is dropped, and the merged runs are restored to
+    their fronts when the merge started. The amount of runs never
+    exceeds the limit then.
+
+    @return False if the merge is not finished.
+    */
+    bool mergeRuns() {
+        std::FILE *file = openRunFile();
+        if (!file) {
+            return false;
+        }
+        // Sort the runs by their amounts of elements left
+        std::vector<std::pair<SizeType, SizeType>> order;
+        for (SizeType i = 0; i < runs.size(); ++i) {
+            order.push_back(std::make_pair(runs[i]->unread + runs[i]->block.size() - runs[i]->pos, i));
+        }
+        std::sort(order.begin(), order.end());
+        const SizeType k = runs.size() / 2 + 1;
+        std::vector<RunState> states;
+        BinaryHeap<Run*, RunPred> mergeHeap;
+        for (SizeType i = 0; i < k && i < order.size(); ++i) {
+            Run *run = runs[order[i].second];
+            const SizeType left = run->block.size() - run->pos - 1;
+            states.push_back(RunState{run, run->front(), run->next - left, run->unread + left});
+            mergeHeap.push(run);
+        }
+        Run *out = new Run(file);
+        SizeType len = 0;
+        bool ok = true;
+        outBlock.reserve(blockLen);
+        while (ok && !mergeHeap.isEmpty()) {
+            Run *run = mergeHeap.top();
+            outBlock.push_back(run->front());
+            if (!advance(run)) {
+                ok = false;
+                break;
+            }
+            if (run->block.empty()) {
+                mergeHeap.pop();
+            } else {
+                mergeHeap.replaceTop(run);
+            }
+            if (outBlock.size() == blockLen || mergeHeap.isEmpty()) {
+                ok = flush(out, len);
+            }
+        }
+        outBlock.clear();
+        runHeap.clear();
+        if (ok) {
+            for (const auto &state : states) {
+                removeRun(state.run);
+            }
+            addRun(out, len);
+        } else {
+            // Only the fronts are kept in memory, and the
+            // rest of the runs are read from their files again
+            for (const auto &state : states) {
+                Run *run = state.run;
+                run->block.assign(1, state.front);
+                run->pos = 0;
+                run->next = state.next;
+                run->unread = state.unread;
+                run->seekNeeded = true;
+            }
+            std::fclose(file);
+            delete out;
+        }
+        runHeap = BinaryHeap<Run*, RunPred>(runs.begin(), runs.end());
+        return ok;
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
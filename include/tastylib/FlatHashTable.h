@@ -0,0 +1,170 @@
+#ifndef TASTYLIB_FLATHASHTABLE_H_
+#define TASTYLIB_FLATHASHTABLE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/internal/flat_table.h"
+#include <functional>
+#include <new>
+#include <utility>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A hash table with the same interface as HashTable, which stores its
+elements in one flat array by open addressing instead of in lists.
+
+Each slot has a one-byte control tag, which is either EMPTY, DELETED
+(a tombstone), or the low 7 bits of the hash value of its element. The
+slots are probed in groups of 16, and all tags of a group are compared
+with the 7 hash bits at once by SSE2 instructions, or by a portable loop
+if SSE2 is not available. So most lookups compare only one element, and
+no pointer is followed. The table grows when the slots in use, including
+tombstones, exceed 7/8 of the capacity.
+
+@param Value The type of the values stored in the hash table.
+@param Pred  A binary predicate that checks if two values are equal.
+             If pred(a, b) == true, then value 'a' and value 'b' are
+             considered equal.
+@param Hash  A unary functor that computes the hash value of an element.
+             Its result is mixed before use, so the identity hash of
+             integers works well.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>,
+         typename Hash = std::hash<Value>>
+class FlatHashTable {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Destructor.
+    */
+    ~FlatHashTable() {}
+
+    /*
+    Initialize the hash table.
+
+    @param n Expected amount of elements. The table grows
+             automatically when more elements are inserted.
+    */
+    FlatHashTable(const SizeType n = 0) : table(n) {}
+
+    FlatHashTable(const FlatHashTable &) = delete;
+    FlatHashTable& operator=(const FlatHashTable &) = delete;
+
+    /*
+    Return the amount of elements in the hash table.
+    */
+    SizeType getSize() const {
+        return table.getSize();
+    }
+
+    /*
+    Return true if the hash table has no elements.
+    */
+    bool isEmpty() const {
+        return table.getSize() == 0;
+    }
+
+    /*
+    Return the amount of slots.
+    */
+    SizeType getCapacity() const {
+        return table.getCapacity();
+    }
+
+    /*
+    Remove all elements from the hash table. The capacity is not changed.
+    */
+    void clear() {
+        table.clear();
+    }
+
+    /*
+    Check if a value is in the hash table.
+
+    @param val The value to be checked
+    */
+    bool has(const Value &val) const {
+        return table.findIndex(val) != Table::NPOS;
+    }
+
+    /*
+    Find a value in the hash table.
+
+    @param val The value to be found
+    @return    The pointer to the stored value that equals 'val'.
+               If the value doesn't exist, return nullptr. The
+               pointer is invalidated when the table grows.
+    */
+    Value* find(const Value &val) {
+        SizeType i = table.findIndex(val);
+        return i == Table::NPOS ? nullptr : &table.slot(i);
+    }
+
+    const Value* find(const Value &val) const {
+        SizeType i = table.findIndex(val);
+        return i == Table::NPOS ? nullptr : &table.slot(i);
+    }
+
+    /*
+    Insert a value to the hash table. If the
+    value exists, this function does nothing.
+
+    @param val The value to be inserted
+    */
+    void insert(const Value &val) {
+        emplace(val);
+    }
+
+    /*
+    Insert a value to the hash table. The value is moved into the
+    table. If the value exists, this function does nothing.
+
+    @param val The value to be inserted
+    */
+    void insert(Value &&val) {
+        emplace(std::move(val));
+    }
+
+    /*
+    Remove a value from the hash table. If the
+    value doesn't exist, this function does nothing.
+
+    @param val The value to be removed
+    */
+    void remove(const Value &val) {
+        const SizeType i = table.findIndex(val);
+        if (i != Table::NPOS) {
+            table.erase(i);
+        }
+    }
+
+    /*
+    Rehash the hash table. The tombstones are removed.
+
+    @param n Expected amount of elements. In practice, the
+             capacity may be greater than needed for 'n'.
+    */
+    void rehash(const SizeType n) {
+        table.rehash(n);
+    }
+
+private:
+    typedef internal::FlatTable<Value, internal::SlotIdentity, Pred, Hash> Table;
+
+    Table table;
+
+    template<typename V>
+    void emplace(V &&val) {
+        const SizeType h = table.hash(val);
+        if (table.findIndex(val, h) == Table::NPOS) {
+            const SizeType i = table.prepareInsert(h);
+            new (&table.slot(i)) Value(std::forward<V>(val));
+            table.commit(i, h);
+        }
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
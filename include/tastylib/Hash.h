@@ -0,0 +1,199 @@
+#ifndef TASTYLIB_HASH_H_
+#define TASTYLIB_HASH_H_
+
+#include "tastylib/internal/base.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+TASTYLIB_NS_BEGIN
+
+namespace internal {
+
+const std::uint64_t HASH_SECRET0 = 0xA0761D6478BD642Full;
+const std::uint64_t HASH_SECRET1 = 0xE7037ED1A0B428DBull;
+const std::uint64_t HASH_SECRET2 = 0x8EBC6AF09C88C6E3ull;
+const std::uint64_t HASH_SECRET3 = 0x589965CC75374CC3ull;
+
+/*
+Multiply two 64-bit integers, and store the low
+64 bits of the product to 'a' and the high to 'b'.
+*/
+inline void mulFull(std::uint64_t &a, std::uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = (unsigned __int128)a * b;
+    a = (std::uint64_t)r;
+    b = (std::uint64_t)(r >> 64);
+#else
+    const std::uint64_t ha = a >> 32, la = (std::uint32_t)a;
+    const std::uint64_t hb = b >> 32, lb = (std::uint32_t)b;
+    const std::uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    const std::uint64_t mid = (ll >> 32) + (std::uint32_t)hl + (std::uint32_t)lh;
+    a = (mid << 32) | (std::uint32_t)ll;
+    b = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+}
+
+/*
+Fold the 128-bit product of two integers to 64 bits.
+*/
+inline std::uint64_t mulFold(std::uint64_t a, std::uint64_t b) {
+    mulFull(a, b);
+    return a ^ b;
+}
+
+inline std::uint64_t read64(const unsigned char *p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t read32(const unsigned char *p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*
+Read 1 to 3 bytes into an integer.
+*/
+inline std::uint64_t readSmall(const unsigned char *p, const std::size_t k) {
+    return ((std::uint64_t)p[0] << 16) | ((std::uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+}
+
+/*
+Mix the bits of an integer, so that every bit of the result depends on
+every bit of the input. This is the finalizer of SplitMix64. It makes
+integer keys safe for tables that take the low bits of the hash values,
+where the identity hash sends strided keys to a few buckets.
+
+@param x The integer to be mixed
+*/
+inline std::uint64_t mixInt(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/*
+Compute the hash value of a sequence of bytes. The algorithm follows
+wyhash: 16 bytes are consumed per 128-bit multiplication, with three
+independent lanes for long inputs, and short inputs are read with a few
+overlapping loads instead of a loop. The bytes are read in the native
+byte order, so the hash values differ between platforms.
+
+@param data The pointer to the bytes
+@param len  The amount of bytes
+@param seed The seed, which gives a different hash function
+*/
+inline std::uint64_t hashBytes(const void *data, const std::size_t len,
+                               std::uint64_t seed = 0) {
+    using namespace internal;
+    const unsigned char *p = static_cast<const unsigned char*>(data);
+    seed ^= mulFold(seed ^ HASH_SECRET0, HASH_SECRET1);
+    std::uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t off = (len >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + off);
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - off);
+        } else if (len > 0) {
+            a = readSmall(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+        if (i > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mulFold(read64(p) ^ HASH_SECRET1, read64(p + 8) ^ seed);
+                see1 = mulFold(read64(p + 16) ^ HASH_SECRET2, read64(p + 24) ^ see1);
+                see2 = mulFold(read64(p + 32) ^ HASH_SECRET3, read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mulFold(read64(p) ^ HASH_SECRET1, read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    a ^= HASH_SECRET1;
+    b ^= seed;
+    mulFull(a, b);
+    return mulFold(a ^ HASH_SECRET0 ^ len, b ^ HASH_SECRET1);
+}
+
+/*
+Combine the hash value of a part of a composite key with the hash
+value of the parts before it. The result depends on the order of
+the parts.
+
+@param seed The hash value of the parts before
+@param h    The hash value of the part
+*/
+inline std::size_t hashCombine(const std::size_t seed, const std::size_t h) {
+    return (std::size_t)mixInt((std::uint64_t)seed ^ ((std::uint64_t)h + 0x9E3779B97F4A7C15ull
+                                                      + ((std::uint64_t)seed << 6)
+                                                      + ((std::uint64_t)seed >> 2)));
+}
+
+/*
+A hash functor whose results are well mixed in all bits, which is
+the default of HashTable.
+
+Integers, enumerations and pointers are mixed by mixInt(), and
+std::string is hashed by hashBytes(), as StringHash does for the same
+characters. A std::pair combines the hash values of its members. Other
+types are hashed by std::hash, and the result is mixed by mixInt().
+*/
+template<typename T, typename Enable = void>
+struct Hasher {
+    std::size_t operator()(const T &val) const {
+        return (std::size_t)mixInt(std::hash<T>()(val));
+    }
+};
+
+template<typename T>
+struct Hasher<T, typename std::enable_if<std::is_integral<T>::value
+                                         || std::is_enum<T>::value>::type> {
+    std::size_t operator()(const T &val) const {
+        return (std::size_t)mixInt(static_cast<std::uint64_t>(val));
+    }
+};
+
+template<typename T>
+struct Hasher<T*> {
+    std::size_t operator()(T *const &ptr) const {
+        return (std::size_t)mixInt(reinterpret_cast<std::uintptr_t>(ptr));
+    }
+};
+
+template<>
+struct Hasher<std::string> {
+    std::size_t operator()(const std::string &str) const {
+        return (std::size_t)hashBytes(str.data(), str.size());
+    }
+};
+
+template<typename T1, typename T2>
+struct Hasher<std::pair<T1, T2>> {
+    std::size_t operator()(const std::pair<T1, T2> &p) const {
+        return hashCombine(Hasher<T1>()(p.first), Hasher<T2>()(p.second));
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef TASTYLIB_HASHMAP_H_
+#define TASTYLIB_HASHMAP_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/internal/flat_table.h"
+#include <functional>
+#include <new>
+#include <utility>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A hash map from unique keys to mapped values, stored in the flat
+open-addressing table of FlatHashTable. Each slot holds a key and its
+mapped value, which are constructed in place.
+
+All lookups are templates that take any key type K for which
+hasher(k) and pred(key, k) are defined, and the results must agree with
+those of the equal Key. So with StringHash and StringEqual, a map of
+std::string keys can be looked up by a StringRef or a C string without
+constructing a std::string. A Key is constructed from K only when a new
+element is inserted.
+
+@param Key    The type of the keys
+@param Mapped The type of the mapped values
+@param Pred   A binary predicate that checks if two keys are equal.
+              If pred(a, b) == true, then key 'a' and key 'b' are
+              considered equal.
+@param Hash   A unary functor that computes the hash value of a key.
+              Its result is mixed before use, so the identity hash of
+              integers works well.
+*/
+template<typename Key, typename Mapped, typename Pred = std::equal_to<Key>,
+         typename Hash = std::hash<Key>>
+class HashMap {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Destructor.
+    */
+    ~HashMap() {}
+
+    /*
+    Initialize the hash map.
+
+    @param n Expected amount of elements. The map grows
+             automatically when more elements are inserted.
+    */
+    HashMap(const SizeType n = 0) : table(n) {}
+
+    HashMap(const HashMap &) = delete;
+    HashMap& operator=(const HashMap &) = delete;
+
+    /*
+    Return the amount of elements in the map.
+    */
+    SizeType getSize() const {
+        return table.getSize();
+    }
+
+    /*
+    Return true if the map has no elements.
+    */
+    bool isEmpty() const {
+        return table.getSize() == 0;
+    }
+
+    /*
+    Return the amount of slots.
+    */
+    SizeType getCapacity() const {
+        return table.getCapacity();
+    }
+
+    /*
+    Remove all elements from the map. The capacity is not changed.
+    */
+    void clear() {
+        table.clear();
+    }
+
+    /*
+    Check if a key is in the map.
+
+    @param key The key to be checked
+    */
+    template<typename K>
+    bool has(const K &key) const {
+        return table.findIndex(key) != Table::NPOS;
+    }
+
+    /*
+    Find the mapped value of a key.
+
+    @param key The key to be found
+    @return    The pointer to the mapped value. If the key doesn't exist,
+               return nullptr. The pointer is invalidated when the map
+               grows.
+    */
+    template<typename K>
+    Mapped* find(const K &key) {
+        const SizeType i = table.findIndex(key);
+        return i == Table::NPOS ? nullptr : &table.slot(i).value;
+    }
+
+    template<typename K>
+    const Mapped* find(const K &key) const {
+        const SizeType i = table.findIndex(key);
+        return i == Table::NPOS ? nullptr : &table.slot(i).value;
+    }
+
+    /*
+    Return the mapped value of a key. If the key doesn't exist, a new
+    element is inserted with a value-initialized mapped value.
+
+    @param key The key
+    */
+    template<typename K>
+    Mapped& operator[](K &&key) {
+        return *tryEmplace(std::forward<K>(key)).first;
+    }
+
+    /*
+    Insert a new element whose mapped value is constructed in place from
+    the given arguments. If the key exists, nothing is constructed.
+
+    @param key  The key
+    @param args The arguments to construct the mapped value
+    @return     The pointer to the mapped value of the key, and true if
+                the element is inserted.
+    */
+    template<typename K, typename... Args>
+    std::pair<Mapped*, bool> tryEmplace(K &&key, Args&&... args) {
+        const SizeType h = table.hash(key);
+        SizeType i = table.findIndex(key, h);
+        if (i != Table::NPOS) {
+            return std::make_pair(&table.slot(i).value, false);
+        }
+        i = table.prepareInsert(h);
+        new (&table.slot(i)) Entry(std::forward<K>(key), std::forward<Args>(args)...);
+        table.commit(i, h);
+        return std::make_pair(&table.slot(i).value, true);
+    }
+
+    /*
+    Set the mapped value of a key, and insert a new element if the
+    key doesn't exist.
+
+    @param key The key
+    @param val The mapped value
+    @return    True if the element is inserted.
+    */
+    template<typename K, typename M>
+    bool insertOrAssign(K &&key, M &&val) {
+        auto res = tryEmplace(std::forward<K>(key), std::forward<M>(val));
+        if (!res.second) {
+            *res.first = std::forward<M>(val);
+        }
+        return res.second;
+    }
+
+    /*
+    Remove a key and its mapped value from the map.
+    If the key doesn't exist, this function does nothing.
+
+    @param key The key to be removed
+    */
+    template<typename K>
+    void remove(const K &key) {
+        const SizeType i = table.findIndex(key);
+        if (i != Table::NPOS) {
+            table.erase(i);
+        }
+    }
+
+    /*
+    Rehash the map. The tombstones are removed.
+
+    @param n Expected amount of elements. In practice, the
+             capacity may be greater than needed for 'n'.
+    */
+    void rehash(const SizeType n) {
+        table.rehash(n);
+    }
+
+    /*
+    Traverse all elements in no particular order.
+
+    @param f The function called with the key and
+             the mapped value of each element
+    */
+    template<typename Func>
+    void traverse(const Func &f) {
+        for (SizeType i = 0; i < table.getCapacity(); ++i) {
+            if (table.isFull(i)) {
+                f(static_cast<const Key&>(table.slot(i).key), table.slot(i).value);
+            }
+        }
+    }
+
+    template<typename Func>
+    void traverse(const Func &f) const {
+        for (SizeType i = 0; i < table.getCapacity(); ++i) {
+            if (table.isFull(i)) {
+                f(static_cast<const Key&>(table.slot(i).key),
+                  static_cast<const Mapped&>(table.slot(i).value));
+            }
+        }
+    }
+
+private:
+    /*
+    An element of the map. The key is not const
+    so that it can be moved when the map grows.
+    */
+    struct Entry {
+        Key key;
+        Mapped value;
+
+        template<typename K, typename... Args>
+        explicit Entry(K &&k, Args&&... args)
+            : key(std::forward<K>(k)), value(std::forward<Args>(args)...) {}
+
+        Entry(Entry &&other)
+            : key(std::move(other.key)), value(std::move(other.value)) {}
+    };
+
+    struct EntryKey {
+        const Key& operator()(const Entry &e) const {
+            return e.key;
+        }
+    };
+
+    typedef internal::FlatTable<Entry, EntryKey, Pred, Hash> Table;
+
+    Table table;
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -3,7 +3,10 @@
 
 #include "tastylib/internal/base.h"
 #include "tastylib/DoublyLinkedList.h"
+#include "tastylib/Hash.h"
 #include <functional>
+#include <new>
+#include <utility>
 #include <vector>
 
 TASTYLIB_NS_BEGIN
@@ -13,24 +16,37 @@ A data structure that stores unique elements in no particular order,
 and which allows for fast retrieval of individual elements based on
 their values.
 
+The table grows automatically when the amount of elements exceeds the
+amount of buckets. The growth is incremental: a new bucket array of
+twice the size is allocated, and each insert() or remove() moves a few
+buckets from the old array to the new one, so no single operation pays
+for the whole rehash. During the growth, an element is in the old array
+if its old bucket has not been moved yet, and in the new array otherwise.
+The nodes are moved by splicing, so a pointer returned by find() stays
+valid until the element is removed. The bucket arrays are allocated in
+segments, so neither allocating the new array nor freeing the old one
+happens at once.
+
 @param Value The type of the values stored in the hash table.
 @param Pred  A binary predicate that checks if two values are equal.
              If pred(a, b) == true, then value 'a' and value 'b' are
              considered equal.
 @param Hash  A unary functor that computes the hash value of an element.
+             The bucket is selected by the low bits of the hash value, so
+             they must be well mixed, as those of Hasher are.
 */
 template<typename Value, typename Pred = std::equal_to<Value>,
-         typename Hash = std::hash<Value>>
+         typename Hash = Hasher<Value>>
 class HashTable {
 public:
     typedef std::size_t SizeType;
-    typedef std::vector<DoublyLinkedList<Value, Pred>> Container;
+    typedef DoublyLinkedList<Value, Pred> Bucket;
 
     /*
     Destructor.
     */
     ~HashTable() {
-        delete buckets;
+        release();
     }
 
     /*
@@ -39,11 +55,13 @@ public:
     @param n Expected buckets amount. In practice, the
              amount of buckets may be greater than 'n'.
     */
-    HashTable(const SizeType n = MIN_BUCKET)
-        : size(0), bucketNum(0), buckets(nullptr) {
+    HashTable(const SizeType n = MIN_BUCKET) : size(0), moved(0) {
         rehash(n);
     }
 
+    HashTable(const HashTable &) = delete;
+    HashTable& operator=(const HashTable &) = delete;
+
     /*
     Return the amount of elements in the hash table.
     */
@@ -58,13 +76,38 @@ public:
         return size == 0;
     }
 
+    /*
+    Return the amount of buckets. During a growth,
+    it is the amount of buckets of the new array.
+    */
+    SizeType getBucketNum() const {
+        return buckets.getNum();
+    }
+
+    /*
+    Return true if the buckets are being moved to a new array.
+    */
+    bool isGrowing() const {
+        return oldBuckets.getNum() != 0;
+    }
+
     /*
     Remove all elements from the hash table.
     */
     void clear() {
+        // Drop the old buckets without hashing their values,
+        // which may refer to objects that no longer exist
+        const SizeType oldNum = oldBuckets.getNum();
+        for (SizeType i = moved; i < oldNum; ++i) {
+            buckets.construct(i);
+            buckets.construct(i + oldNum);
+            oldBuckets.destroy(i);
+        }
+        oldBuckets.init(0);
+        moved = 0;
         size = 0;
-        for (SizeType i = 0; i < bucketNum; ++i) {
-            (*buckets)[i].clear();
+        for (SizeType i = 0; i < buckets.getNum(); ++i) {
+            buckets[i].clear();
         }
     }
 
@@ -74,10 +117,31 @@ public:
     @param val The value to be checked
     */
     bool has(const Value &val) const {
-        const auto &list = (*buckets)[hash(val)];
-        return list.find(val) != -1;
+        return bucketOf(val).find(val) != -1;
     }
 
+    /*
+    Find a value in the hash table.
+
+    @param val The value to be found
+    @return    The pointer to the stored value that equals 'val'.
+               If the value doesn't exist, return nullptr.
+    */
+    Value* find(const Value &val) {
+        auto &list = bucketOf(val);
+        auto it = list.findIf([&](const Value &v) {
+            return pred(v, val);
+        });
+        return it == list.end() ? nullptr : &*it;
+    }
+
+    const Value* find(const Value &val) const {
+        const auto &list = bucketOf(val);
+        auto it = list.findIf([&](const Value &v) {
+            return pred(v, val);
+        });
+        return it == list.end() ? nullptr : &*it;
+    }
 
     /*
     Insert a value to the hash table. If the
@@ -86,10 +150,13 @@ public:
     @param val The value to be inserted
     */
     void insert(const Value &val) {
-        auto &list = (*buckets)[hash(val)];
+        step();
+        auto &list = bucketOf(val);
         if (list.find(val) == -1) {
             list.insertBack(val);
-            ++size;
+            if (++size > buckets.getNum() * MAX_LOAD) {
+                grow();
+            }
         }
     }
 
@@ -100,60 +167,258 @@ public:
     @param val The value to be removed
     */
     void remove(const Value &val) {
-        auto &list = (*buckets)[hash(val)];
-        auto pos = list.find(val);
-        if (pos != -1) {
-            list.remove(pos);
+        step();
+        auto &list = bucketOf(val);
+        auto it = list.findIf([&](const Value &v) {
+            return pred(v, val);
+        });
+        if (it != list.end()) {
+            list.erase(it);
             --size;
         }
     }
 
     /*
-    Rehash the hash table.
+    Rehash the hash table at once. The nodes are spliced
+    to the new buckets without being copied.
 
     @param n Expected buckets amount. In practice, the
              amount of buckets may be greater than 'n'.
     */
     void rehash(const SizeType n) {
-        size = 0;
-        SizeType oldNum = bucketNum;
-        bucketNum = MIN_BUCKET;
-        while (bucketNum < n) {
-            bucketNum <<= 1;
+        finishGrowth();
+        SizeType num = MIN_BUCKET;
+        while (num < n) {
+            num <<= 1;
         }
-        Container *oldBuckets = buckets;
-        buckets = new Container(bucketNum);
-        for (SizeType i = 0; i < oldNum; ++i) {
-            const auto &list = (*oldBuckets)[i];
-            list.traverse([&](const SizeType pos, const Value &val) {
-                UNUSED(pos);
-                insert(val);
-            });
+        oldBuckets.swap(buckets);
+        buckets.init(num);
+        for (SizeType i = 0; i < num; ++i) {
+            buckets.construct(i);
         }
-        delete oldBuckets;
+        for (SizeType i = 0; i < oldBuckets.getNum(); ++i) {
+            moveBucket(oldBuckets[i]);
+            oldBuckets.destroy(i);
+        }
+        oldBuckets.init(0);
     }
 
 private:
     static const SizeType MIN_BUCKET = 8;
 
+    /*
+    The maximum average amount of elements per bucket.
+    */
+    static const SizeType MAX_LOAD = 1;
+
+    /*
+    The amount of old buckets moved by each insert() or remove().
+    A growth from n to 2 * n buckets starts when size > n. The next one
+    starts when size > 2 * n and would move the remaining old buckets
+    at once, and at least n calls of insert() come before that. Every
+    call of insert() or remove() moves buckets, even if it doesn't change
+    the size, so one bucket per call is the least that avoids the pause.
+    Two buckets end each growth within n / 2 calls, halfway to the next.
+    */
+    static const SizeType MOVE_STEP = 2;
+
+    /*
+    The maximum amount of buckets in a segment of a bucket array.
+    */
+    static const SizeType SEGMENT_LEN = 4096;
+
+    /*
+    An array of buckets stored in segments of at most SEGMENT_LEN
+    buckets. A segment is allocated when its first bucket is constructed,
+    and freed when its last bucket is destroyed, so a growth allocates
+    the new array and frees the old one a little at a time instead of
+    touching or unmapping a large block at once.
+    */
+    class BucketArray {
+    public:
+        ~BucketArray() {
+            init(0);
+        }
+
+        BucketArray() : num(0), shift(0) {}
+
+        BucketArray(const BucketArray &) = delete;
+        BucketArray& operator=(const BucketArray &) = delete;
+
+        /*
+        Free all segments and make room for the segments of n buckets,
+        where n is 0 or a power of 2. The buckets must be destroyed.
+        */
+        void init(const SizeType n) {
+            for (Bucket *seg : segs) {
+                ::operator delete(seg);
+            }
+            num = n;
+            shift = 0;
+            while (((SizeType)1 << shift) < n && ((SizeType)1 << shift) < SEGMENT_LEN) {
+                ++shift;
+            }
+            segs.assign(n >> shift, nullptr);
+        }
+
+        void swap(BucketArray &other) {
+            segs.swap(other.segs);
+            std::swap(num, other.num);
+            std::swap(shift, other.shift);
+        }
+
+        SizeType getNum() const {
+            return num;
+        }
+
+        Bucket& operator[](const SizeType i) const {
+            return segs[i >> shift][i & (((SizeType)1 << shift) - 1)];
+        }
+
+        /*
+        Construct bucket i, and allocate its segment if needed.
+        */
+        void construct(const SizeType i) {
+            Bucket *&seg = segs[i >> shift];
+            if (!seg) {
+                seg = static_cast<Bucket*>(::operator new(sizeof(Bucket) << shift));
+            }
+            new (seg + (i & (((SizeType)1 << shift) - 1))) Bucket();
+        }
+
+        /*
+        Destroy bucket i, and free its segment if it is the last one.
+        The buckets of a segment must be destroyed in order.
+        */
+        void destroy(const SizeType i) {
+            const SizeType mask = ((SizeType)1 << shift) - 1;
+            Bucket *&seg = segs[i >> shift];
+            seg[i & mask].~Bucket();
+            if ((i & mask) == mask) {
+                ::operator delete(seg);
+                seg = nullptr;
+            }
+        }
+
+    private:
+        SizeType num;
+        SizeType shift;  // log2 of the amount of buckets in a segment
+        std::vector<Bucket*> segs;
+    };
+
     Pred pred;
     Hash hasher;
 
     SizeType size;
-    SizeType bucketNum;
-    Container *buckets;
+    BucketArray buckets;
 
     /*
-    The function to compute the hash value of an element.
+    The old bucket array during a growth, which is empty otherwise.
+    oldBuckets[i] for i < moved have been moved and destroyed.
+    buckets[i] and buckets[i + oldNum] are constructed when
+    oldBuckets[i] is moved.
+    */
+    BucketArray oldBuckets;
+    SizeType moved;
 
-    @param val The element
-    @return The hash value of the element
+    /*
+    Return the bucket where a value is or should be.
+    */
+    const Bucket& bucketOf(const Value &val) const {
+        const SizeType h = (SizeType)hasher(val);
+        const SizeType oldNum = oldBuckets.getNum();
+        if (oldNum != 0 && (h & (oldNum - 1)) >= moved) {
+            return oldBuckets[h & (oldNum - 1)];
+        }
+        return buckets[h & (buckets.getNum() - 1)];
+    }
+
+    Bucket& bucketOf(const Value &val) {
+        return const_cast<Bucket&>(static_cast<const HashTable*>(this)->bucketOf(val));
+    }
+
+    /*
+    Splice all nodes of a bucket to their buckets in the current array.
+    */
+    void moveBucket(Bucket &from) {
+        const SizeType mask = buckets.getNum() - 1;
+        while (!from.isEmpty()) {
+            auto it = from.begin();
+            Bucket &to = buckets[(SizeType)hasher(*it) & mask];
+            to.splice(to.end(), from, it);
+        }
+    }
+
+    /*
+    Start moving the buckets to a new array of twice the size.
     */
-    SizeType hash(const Value &val) const {
-        return (SizeType)(hasher(val) & (bucketNum - 1));
+    void grow() {
+        finishGrowth();
+        const SizeType num = buckets.getNum();
+        oldBuckets.swap(buckets);
+        buckets.init(num * 2);
+        moved = 0;
+    }
+
+    /*
+    Move at most 'cnt' old buckets to the new array.
+    */
+    void step(const SizeType cnt = MOVE_STEP) {
+        const SizeType oldNum = oldBuckets.getNum();
+        if (oldNum == 0) {
+            return;
+        }
+        for (SizeType k = 0; k < cnt && moved < oldNum; ++k, ++moved) {
+            buckets.construct(moved);
+            buckets.construct(moved + oldNum);
+            moveBucket(oldBuckets[moved]);
+            oldBuckets.destroy(moved);
+        }
+        if (moved == oldNum) {
+            oldBuckets.init(0);
+            moved = 0;
+        }
+    }
+
+    void finishGrowth() {
+        step(oldBuckets.getNum());
+    }
+
+    /*
+    Destroy all constructed buckets. The segments are freed
+    by the destructors of the arrays.
+    */
+    void release() {
+        const SizeType oldNum = oldBuckets.getNum();
+        if (oldNum == 0) {
+            for (SizeType i = 0; i < buckets.getNum(); ++i) {
+                buckets[i].~Bucket();
+            }
+            return;
+        }
+        for (SizeType i = 0; i < oldNum; ++i) {
+            if (i < moved) {
+                buckets[i].~Bucket();
+                buckets[i + oldNum].~Bucket();
+            } else {
+                oldBuckets[i].~Bucket();
+            }
+        }
     }
 };
 
+template<typename Value, typename Pred, typename Hash>
+const typename HashTable<Value, Pred, Hash>::SizeType HashTable<Value, Pred, Hash>::MIN_BUCKET;
+
+template<typename Value, typename Pred, typename Hash>
+const typename HashTable<Value, Pred, Hash>::SizeType HashTable<Value, Pred, Hash>::MAX_LOAD;
+
+template<typename Value, typename Pred, typename Hash>
+const typename HashTable<Value, Pred, Hash>::SizeType HashTable<Value, Pred, Hash>::MOVE_STEP;
+
+template<typename Value, typename Pred, typename Hash>
+const typename HashTable<Value, Pred, Hash>::SizeType HashTable<Value, Pred, Hash>::SEGMENT_LEN;
+
 TASTYLIB_NS_END
 
 #endif
@@ -0,0 +1,473 @@
+#ifndef TASTYLIB_INDEXABLESKIPLIST_H_
+#define TASTYLIB_INDEXABLESKIPLIST_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <iterator>
+#include <cstdint>
+#include <new>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A doubly linked list with an indexable skip list built over its nodes.
+Each forward link of the skip list records how many nodes it spans, so
+a node at any position is reached in O(logn) expected time. The bottom
+level links every node in order, which keeps sequential traversal as
+cheap as that of DoublyLinkedList.
+
+@param Value The type of list node value.
+@param Pred  A binary predicate that checks if two node values
+             are equal. If Pred(a, b) == true, then value 'a'
+             and value 'b' are considered equal.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>>
+class IndexableSkipList {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    The maximum level of a node. With a promotion probability
+    of 1/4, it suits lists of up to 4^16 nodes.
+    */
+    static const int MAX_LEVEL = 16;
+
+    struct Node;
+
+    /*
+    A forward link of the skip list.
+    */
+    struct Link {
+        Node *next;
+        SizeType span;  // Amount of positions between the two linked nodes
+    };
+
+    /*
+    A list node. Its forward links are stored in the same allocation
+    right after the node, one for each level of the node.
+    */
+    struct Node {
+        Value val;
+        Node *prev;
+
+        explicit Node(const Value &v) : val(v), prev(nullptr) {}
+
+        Link* links() {
+            return reinterpret_cast<Link*>(this + 1);
+        }
+
+        const Link* links() const {
+            return reinterpret_cast<const Link*>(this + 1);
+        }
+
+        Node* next() const {
+            return links()[0].next;
+        }
+    };
+
+    /*
+    Bidirectional iterator of the list. Decrementing the
+    end iterator moves it to the last node of the list.
+
+    @param Ref The reference type of the node value
+    @param Ptr The pointer type of the node value
+    */
+    template<typename Ref, typename Ptr>
+    class IteratorImpl {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+
+        IteratorImpl() : node(nullptr), list(nullptr) {}
+
+        /*
+        Copy constructor. It also converts a mutable
+        iterator to a constant one.
+        */
+        IteratorImpl(const IteratorImpl<Value&, Value*> &it)
+            : node(it.node), list(it.list) {}
+
+        IteratorImpl& operator=(const IteratorImpl &it) = default;
+
+        Ref operator*() const {
+            return node->val;
+        }
+
+        Ptr operator->() const {
+            return &node->val;
+        }
+
+        IteratorImpl& operator++() {
+            node = node->next();
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp(*this);
+            node = node->next();
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            node = (node ? node->prev : list->tail);
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp(*this);
+            node = (node ? node->prev : list->tail);
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl &it) const {
+            return node == it.node;
+        }
+
+        bool operator!=(const IteratorImpl &it) const {
+            return node != it.node;
+        }
+
+    private:
+        friend class IndexableSkipList;
+        template<typename, typename> friend class IteratorImpl;
+
+        Node *node;
+        const IndexableSkipList *list;
+
+        IteratorImpl(Node *n, const IndexableSkipList *l)
+            : node(n), list(l) {}
+    };
+
+    typedef IteratorImpl<Value&, Value*> Iterator;
+    typedef IteratorImpl<const Value&, const Value*> ConstIterator;
+
+    /*
+    Destructor.
+    */
+    ~IndexableSkipList() {
+        clear();
+    }
+
+    /*
+    Default constructor.
+    */
+    IndexableSkipList() : size(0), level(1), tail(nullptr), seed(2463534242u) {
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            head[i].next = nullptr;
+            head[i].span = 0;
+        }
+    }
+
+    IndexableSkipList(const IndexableSkipList &) = delete;
+    IndexableSkipList& operator=(const IndexableSkipList &) = delete;
+
+    /*
+    Return the amount of nodes in the list.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the list is empty.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Clear the content of the list.
+    */
+    void clear() {
+        Node *tmp = head[0].next, *del;
+        while (tmp) {
+            del = tmp;
+            tmp = tmp->next();
+            destroyNode(del);
+        }
+        for (int i = 0; i < level; ++i) {
+            head[i].next = nullptr;
+            head[i].span = 0;
+        }
+        level = 1;
+        tail = nullptr;
+        size = 0;
+    }
+
+    /*
+    Return the iterator to the first node.
+    */
+    Iterator begin() {
+        return Iterator(head[0].next, this);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(head[0].next, this);
+    }
+
+    /*
+    Return the iterator past the last node.
+    */
+    Iterator end() {
+        return Iterator(nullptr, this);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr, this);
+    }
+
+    /*
+    Traverse the list nodes.
+
+    @param f The function to traverse each node. Params are:
+             @param pos The position of the current traversing node
+             @param val The value of the current traversing node
+    */
+    void traverse(const std::function<void(const SizeType pos,
+                                           const Value &val)> &f) const {
+        SizeType pos = 0;
+        for (const Node *n = head[0].next; n; n = n->next()) {
+            f(pos++, n->val);
+        }
+    }
+
+    /*
+    Find a node in the list.
+
+    @param val_ The value of the node to be found
+    @return     The first matching position of the node with value 'val_'.
+                If the node does not exist, return -1.
+    */
+    int find(const Value &val_) const {
+        Pred pred;
+        int pos = 0;
+        for (const Node *n = head[0].next; n; n = n->next(), ++pos) {
+            if (pred(n->val, val_)) {
+                return pos;
+            }
+        }
+        return -1;
+    }
+
+    /*
+    Return the value of the node at a given position.
+    Precondition: The position is less than the list's size.
+
+    @param pos The position of the node
+    */
+    Value& at(const SizeType pos) {
+        return nodeAt(pos)->val;
+    }
+
+    const Value& at(const SizeType pos) const {
+        return nodeAt(pos)->val;
+    }
+
+    /*
+    Insert a node at a given position. If the position is greater than
+    the list's size, the node will be inserted to the back of the list.
+
+    @param pos The position to insert the node
+    @param val The value of the node to be inserted
+    */
+    void insert(SizeType pos, const Value &val) {
+        pos = (pos > size ? size : pos);
+        Link *update[MAX_LEVEL] = {};
+        SizeType rank[MAX_LEVEL];
+        Node *prev = findPrev(pos, update, rank);
+        int l = randomLevel();
+        if (l > level) {
+            for (int i = level; i < l; ++i) {
+                update[i] = head;
+                rank[i] = 0;
+                head[i].span = size;
+            }
+            level = l;
+        }
+        Node *n = createNode(val, l);
+        Link *links = n->links();
+        for (int i = 0; i < l; ++i) {
+            links[i].next = update[i][i].next;
+            links[i].span = update[i][i].span - (pos - rank[i]);
+            update[i][i].next = n;
+            update[i][i].span = pos - rank[i] + 1;
+        }
+        for (int i = l; i < level; ++i) {
+            ++update[i][i].span;
+        }
+        n->prev = prev;
+        if (links[0].next) {
+            links[0].next->prev = n;
+        } else {
+            tail = n;
+        }
+        ++size;
+    }
+
+    /*
+    Insert a node at the front of the list.
+
+    @param val The value of the node to be inserted
+    */
+    void insertFront(const Value &val) {
+        insert(0, val);
+    }
+
+    /*
+    Insert a node at the back of the list.
+
+    @param val The value of the node to be inserted
+    */
+    void insertBack(const Value &val) {
+        insert(size, val);
+    }
+
+    /*
+    Remove a node at a given position. If there is no node
+    at the given position, this function does nothing.
+
+    @param pos The position of the node to be removed
+    */
+    void remove(const SizeType pos) {
+        if (pos >= size) {
+            return;
+        }
+        Link *update[MAX_LEVEL] = {};
+        SizeType rank[MAX_LEVEL];
+        Node *prev = findPrev(pos, update, rank);
+        Node *del = update[0][0].next;
+        Link *links = del->links();
+        for (int i = 0; i < level; ++i) {
+            if (update[i][i].next == del) {
+                update[i][i].next = links[i].next;
+                update[i][i].span += links[i].span - 1;
+            } else {
+                --update[i][i].span;
+            }
+        }
+        if (links[0].next) {
+            links[0].next->prev = prev;
+        } else {
+            tail = prev;
+        }
+        while (level > 1 && !head[level - 1].next) {
+            --level;
+        }
+        destroyNode(del);
+        --size;
+    }
+
+    /*
+    Remove the first node of the list.
+    */
+    void removeFront() {
+        remove(0);
+    }
+
+    /*
+    Remove the last node of the list.
+    */
+    void removeBack() {
+        if (!isEmpty()) {
+            remove(size - 1);
+        }
+    }
+
+private:
+    SizeType size;
+    int level;
+    Link head[MAX_LEVEL];
+    Node *tail;
+    std::uint32_t seed;
+
+    /*
+    Allocate a node and its forward links in one block.
+
+    @param val The value of the node
+    @param l   The level of the node
+    */
+    static Node* createNode(const Value &val, const int l) {
+        void *p = ::operator new(sizeof(Node) + l * sizeof(Link));
+        return new (p) Node(val);
+    }
+
+    static void destroyNode(Node *n) {
+        n->~Node();
+        ::operator delete(n);
+    }
+
+    /*
+    Return a random level in [1, MAX_LEVEL]. A node reaches
+    each next level with the probability of 1/4.
+    */
+    int randomLevel() {
+        // Xorshift
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int l = 1;
+        for (std::uint32_t bits = seed; l < MAX_LEVEL && (bits & 3) == 0; bits >>= 2) {
+            ++l;
+        }
+        return l;
+    }
+
+    /*
+    Find the rightmost forward link on each level that
+    ends at or before a given position.
+
+    @param pos    The given position
+    @param update Output. update[i] is the links array that owns
+                  the found link on level i.
+    @param rank   Output. rank[i] is the rank of the owner of update[i].
+                  The head ranks 0 and the node at position k ranks k + 1.
+    @return       The node right before the position, or
+                  null if the position is 0.
+    */
+    Node* findPrev(const SizeType pos, Link **update, SizeType *rank) {
+        Link *x = head;
+        Node *xn = nullptr;
+        SizeType r = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x[i].next && r + x[i].span <= pos) {
+                r += x[i].span;
+                xn = x[i].next;
+                x = xn->links();
+            }
+            update[i] = x;
+            rank[i] = r;
+        }
+        return xn;
+    }
+
+    /*
+    Return the node at a given position.
+    Precondition: The position is less than the list's size.
+    */
+    Node* nodeAt(const SizeType pos) const {
+        const Link *x = head;
+        Node *xn = nullptr;
+        SizeType r = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x[i].next && r + x[i].span <= pos + 1) {
+                r += x[i].span;
+                xn = x[i].next;
+                x = xn->links();
+            }
+            if (r == pos + 1) {
+                break;
+            }
+        }
+        return xn;
+    }
+};
+
+template<typename Value, typename Pred>
+const int IndexableSkipList<Value, Pred>::MAX_LEVEL;
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,383 @@
+#ifndef TASTYLIB_INTRUSIVELIST_H_
+#define TASTYLIB_INTRUSIVELIST_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
+
+TASTYLIB_NS_BEGIN
+
+/*
+The links that an object embeds to be put into an IntrusiveList. An
+object can be put into several lists at once by embedding one hook
+for each list. Copying an object does not copy the links of its hooks.
+*/
+class IntrusiveListHook {
+public:
+    IntrusiveListHook() : prev(nullptr), next(nullptr) {}
+
+    IntrusiveListHook(const IntrusiveListHook &) : prev(nullptr), next(nullptr) {}
+
+    IntrusiveListHook& operator=(const IntrusiveListHook &) {
+        return *this;
+    }
+
+    /*
+    Return true if the hook is in a list.
+    */
+    bool isLinked() const {
+        return next != nullptr;
+    }
+
+private:
+    template<typename T, IntrusiveListHook T::*Member> friend class IntrusiveList;
+
+    IntrusiveListHook *prev;
+    IntrusiveListHook *next;
+};
+
+/*
+A doubly linked list of objects that embed their own links. The list
+never allocates memory and never copies the objects, so it only stores
+references to objects owned by the caller. An object must be removed
+from the list before it is destroyed.
+
+@param T      The type of the objects in the list.
+@param Member The hook member of type T that the list links.
+*/
+template<typename T, IntrusiveListHook T::*Member>
+class IntrusiveList {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Bidirectional iterator of the list. Decrementing the
+    end iterator moves it to the last object of the list.
+
+    @param Ref The reference type of the object
+    @param Ptr The pointer type of the object
+    */
+    template<typename Ref, typename Ptr>
+    class IteratorImpl {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+
+        IteratorImpl() : hook(nullptr) {}
+
+        /*
+        Copy constructor. It also converts a mutable
+        iterator to a constant one.
+        */
+        IteratorImpl(const IteratorImpl<T&, T*> &it) : hook(it.hook) {}
+
+        IteratorImpl& operator=(const IteratorImpl &it) = default;
+
+        Ref operator*() const {
+            return *owner(hook);
+        }
+
+        Ptr operator->() const {
+            return owner(hook);
+        }
+
+        IteratorImpl& operator++() {
+            hook = hook->next;
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp(*this);
+            hook = hook->next;
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            hook = hook->prev;
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp(*this);
+            hook = hook->prev;
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl &it) const {
+            return hook == it.hook;
+        }
+
+        bool operator!=(const IteratorImpl &it) const {
+            return hook != it.hook;
+        }
+
+    private:
+        friend class IntrusiveList;
+        template<typename, typename> friend class IteratorImpl;
+
+        IntrusiveListHook *hook;
+
+        explicit IteratorImpl(IntrusiveListHook *h) : hook(h) {}
+    };
+
+    typedef IteratorImpl<T&, T*> Iterator;
+    typedef IteratorImpl<const T&, const T*> ConstIterator;
+
+    /*
+    Destructor. The objects in the list are unlinked.
+    */
+    ~IntrusiveList() {
+        clear();
+    }
+
+    /*
+    Default constructor.
+    */
+    IntrusiveList() : size(0) {
+        sentinel.prev = sentinel.next = &sentinel;
+    }
+
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList& operator=(const IntrusiveList &) = delete;
+
+    /*
+    Return the amount of objects in the list.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the list is empty.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Unlink all objects from the list.
+    */
+    void clear() {
+        IntrusiveListHook *h = sentinel.next;
+        while (h != &sentinel) {
+            IntrusiveListHook *next = h->next;
+            h->prev = h->next = nullptr;
+            h = next;
+        }
+        sentinel.prev = sentinel.next = &sentinel;
+        size = 0;
+    }
+
+    /*
+    Return the iterator to the first object.
+    */
+    Iterator begin() {
+        return Iterator(sentinel.next);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(sentinel.next);
+    }
+
+    /*
+    Return the iterator past the last object.
+    */
+    Iterator end() {
+        return Iterator(const_cast<IntrusiveListHook*>(&sentinel));
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(const_cast<IntrusiveListHook*>(&sentinel));
+    }
+
+    /*
+    Return the iterator to an object in the list.
+
+    @param obj The object. It must be in this list.
+    */
+    Iterator iteratorTo(T &obj) {
+        return Iterator(&(obj.*Member));
+    }
+
+    /*
+    Return the first object of the list.
+    Precondition: The list is not empty.
+    */
+    T& front() {
+        return *owner(sentinel.next);
+    }
+
+    const T& front() const {
+        return *owner(sentinel.next);
+    }
+
+    /*
+    Return the last object of the list.
+    Precondition: The list is not empty.
+    */
+    T& back() {
+        return *owner(sentinel.prev);
+    }
+
+    const T& back() const {
+        return *owner(sentinel.prev);
+    }
+
+    /*
+    Traverse the list objects.
+
+    @param f The function to traverse each object. Params are:
+             @param pos The position of the current traversing object
+             @param obj The current traversing object
+    */
+    void traverse(const std::function<void(const SizeType pos,
+                                           const T &obj)> &f) const {
+        SizeType pos = 0;
+        for (const IntrusiveListHook *h = sentinel.next; h != &sentinel; h = h->next) {
+            f(pos++, *owner(h));
+        }
+    }
+
+    /*
+    Link an object before the object that an iterator points to.
+    Precondition: The hook of the object is not linked.
+
+    @param pos The iterator before which the object is linked
+    @param obj The object to be linked
+    @return    The iterator to the linked object
+    */
+    Iterator insert(ConstIterator pos, T &obj) {
+        IntrusiveListHook *h = &(obj.*Member);
+        link(pos.hook, h);
+        return Iterator(h);
+    }
+
+    /*
+    Link an object to the front of the list.
+    Precondition: The hook of the object is not linked.
+
+    @param obj The object to be linked
+    */
+    void insertFront(T &obj) {
+        link(sentinel.next, &(obj.*Member));
+    }
+
+    /*
+    Link an object to the back of the list.
+    Precondition: The hook of the object is not linked.
+
+    @param obj The object to be linked
+    */
+    void insertBack(T &obj) {
+        link(&sentinel, &(obj.*Member));
+    }
+
+    /*
+    Unlink an object from the list in O(1) time. If the hook
+    of the object is not linked, this function does nothing.
+
+    @param obj The object to be unlinked. If it is linked,
+               it must be in this list.
+    */
+    void remove(T &obj) {
+        IntrusiveListHook *h = &(obj.*Member);
+        if (h->isLinked()) {
+            unlink(h);
+        }
+    }
+
+    /*
+    Unlink the object that an iterator points to.
+
+    @param pos The iterator to the object to be unlinked
+    @return    The iterator to the object after the unlinked one
+    */
+    Iterator erase(ConstIterator pos) {
+        IntrusiveListHook *next = pos.hook->next;
+        unlink(pos.hook);
+        return Iterator(next);
+    }
+
+    /*
+    Unlink the first object of the list.
+    */
+    void removeFront() {
+        if (!isEmpty()) {
+            unlink(sentinel.next);
+        }
+    }
+
+    /*
+    Unlink the last object of the list.
+    */
+    void removeBack() {
+        if (!isEmpty()) {
+            unlink(sentinel.prev);
+        }
+    }
+
+    /*
+    Move an object of the list to its front in O(1) time.
+
+    @param obj The object. It must be in this list.
+    */
+    void moveToFront(T &obj) {
+        IntrusiveListHook *h = &(obj.*Member);
+        if (sentinel.next != h) {
+            unlink(h);
+            link(sentinel.next, h);
+        }
+    }
+
+private:
+    SizeType size;
+    IntrusiveListHook sentinel;  // The list is a ring closed by this hook
+
+    /*
+    Return the offset of the hook member in an object.
+    */
+    static std::ptrdiff_t hookOffset() {
+        static const typename std::aligned_storage<sizeof(T), alignof(T)>::type dummy = {};
+        const T *obj = reinterpret_cast<const T*>(&dummy);
+        return reinterpret_cast<const char*>(&(obj->*Member))
+               - reinterpret_cast<const char*>(obj);
+    }
+
+    /*
+    Return the object that owns a hook.
+    */
+    static T* owner(const IntrusiveListHook *h) {
+        return reinterpret_cast<T*>(const_cast<char*>(
+            reinterpret_cast<const char*>(h) - hookOffset()));
+    }
+
+    /*
+    Link a hook before a given hook.
+    */
+    void link(IntrusiveListHook *pos, IntrusiveListHook *h) {
+        h->next = pos;
+        h->prev = pos->prev;
+        pos->prev->next = h;
+        pos->prev = h;
+        ++size;
+    }
+
+    /*
+    Unlink a hook and reset its links.
+    */
+    void unlink(IntrusiveListHook *h) {
+        h->prev->next = h->next;
+        h->next->prev = h->prev;
+        h->prev = h->next = nullptr;
+        --size;
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef TASTYLIB_LRUCACHE_H_
+#define TASTYLIB_LRUCACHE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/DoublyLinkedList.h"
+#include "tastylib/Hash.h"
+#include "tastylib/HashTable.h"
+#include <functional>
+
+TASTYLIB_NS_BEGIN
+
+namespace internal {
+
+/*
+An entry of the hash table of a cache. It points to the key stored
+in a list node, so the key is neither copied nor stored twice.
+
+@param Key      The type of the cache keys.
+@param Iterator The type of the iterator to the list node.
+*/
+template<typename Key, typename Iterator>
+struct CacheEntry {
+    const Key *key;
+    Iterator it;
+};
+
+template<typename Entry, typename Pred>
+struct CacheEntryPred {
+    bool operator()(const Entry &a, const Entry &b) const {
+        return pred(*a.key, *b.key);
+    }
+
+    Pred pred;
+};
+
+template<typename Entry, typename Hash>
+struct CacheEntryHash {
+    std::size_t operator()(const Entry &e) const {
+        return hasher(*e.key);
+    }
+
+    Hash hasher;
+};
+
+}
+
+/*
+A fixed-capacity key-value cache that evicts the least recently used
+item when it is full. A DoublyLinkedList keeps the items from the most
+recently used to the least recently used, and a HashTable maps each
+key to its list node. All operations take O(1) expected time.
+
+@param Key   The type of the cache keys.
+@param Value The type of the cache values.
+@param Pred  A binary predicate that checks if two keys are equal.
+             If pred(a, b) == true, then key 'a' and key 'b' are
+             considered equal.
+@param Hash  A unary functor that computes the hash value of a key.
+*/
+template<typename Key, typename Value, typename Pred = std::equal_to<Key>,
+         typename Hash = Hasher<Key>>
+class LruCache {
+public:
+    typedef std::size_t SizeType;
+    typedef std::function<void(const Key &key, const Value &val)> Callback;
+
+    struct Item {
+        Key key;
+        Value val;
+    };
+
+    /*
+    Initialize an empty cache.
+
+    @param capacity_ The maximum amount of items in the cache. It is at least 1.
+    @param onEvict_  The function called with an item right before
+                     the item is evicted. It may be empty.
+    */
+    explicit LruCache(const SizeType capacity_, const Callback &onEvict_ = Callback())
+        : capacity(capacity_ ? capacity_ : 1), onEvict(onEvict_), table(capacity) {}
+
+    LruCache(const LruCache &) = delete;
+    LruCache& operator=(const LruCache &) = delete;
+
+    /*
+    Return the amount of items in the cache.
+    */
+    SizeType getSize() const {
+        return items.getSize();
+    }
+
+    /*
+    Return the maximum amount of items in the cache.
+    */
+    SizeType getCapacity() const {
+        return capacity;
+    }
+
+    /*
+    Return true if the cache is empty.
+    */
+    bool isEmpty() const {
+        return items.isEmpty();
+    }
+
+    /*
+    Remove all items from the cache. The eviction callback is not called.
+    */
+    void clear() {
+        table.clear();
+        items.clear();
+    }
+
+    /*
+    Check if a key is in the cache. Unlike get(),
+    it does not mark the item as recently used.
+
+    @param key The key to be checked
+    */
+    bool has(const Key &key) const {
+        return table.find(probe(key)) != nullptr;
+    }
+
+    /*
+    Look up the value of a key and mark the item as the most recently used.
+
+    @param key The key to look up
+    @return    The pointer to the cached value. If the key is not in
+               the cache, return nullptr. The pointer stays valid until
+               the item is evicted or removed.
+    */
+    Value* get(const Key &key) {
+        Entry *e = table.find(probe(key));
+        if (!e) {
+            return nullptr;
+        }
+        items.splice(items.begin(), items, e->it);
+        return &e->it->val;
+    }
+
+    /*
+    Insert or update an item and mark it as the most recently used.
+    If a new item does not fit, the least recently used item is evicted.
+
+    @param key The key of the item
+    @param val The value of the item
+    */
+    void put(const Key &key, const Value &val) {
+        Entry *e = table.find(probe(key));
+        if (e) {
+            e->it->val = val;
+            items.splice(items.begin(), items, e->it);
+            return;
+        }
+        if (items.getSize() == capacity) {
+            evict();
+        }
+        auto it = items.insert(items.begin(), Item{key, val});
+        table.insert(Entry{&it->key, it});
+    }
+
+    /*
+    Remove an item from the cache. If the key doesn't exist,
+    this function does nothing. The eviction callback is not called.
+
+    @param key The key of the item to be removed
+    */
+    void remove(const Key &key) {
+        Entry *e = table.find(probe(key));
+        if (e) {
+            auto it = e->it;
+            table.remove(*e);
+            items.erase(it);
+        }
+    }
+
+private:
+    typedef typename DoublyLinkedList<Item>::Iterator Iterator;
+    typedef internal::CacheEntry<Key, Iterator> Entry;
+    typedef HashTable<Entry, internal::CacheEntryPred<Entry, Pred>,
+                      internal::CacheEntryHash<Entry, Hash>> Table;
+
+    SizeType capacity;
+    Callback onEvict;
+    DoublyLinkedList<Item> items;  // From the most to the least recently used
+    Table table;
+
+    static Entry probe(const Key &key) {
+        return Entry{&key, Iterator()};
+    }
+
+    /*
+    Evict the least recently used item.
+    */
+    void evict() {
+        auto it = --items.end();
+        if (onEvict) {
+            onEvict(it->key, it->val);
+        }
+        table.remove(probe(it->key));
+        items.erase(it);
+    }
+};
+
+/*
+A fixed-capacity key-value cache that evicts the least frequently used
+item when it is full. Ties are broken by evicting the least recently
+used one. The items are kept in one DoublyLinkedList ordered by their
+use counts, and a second HashTable maps each use count to the first
+item of its group, so an item moves to the next group in O(1) time.
+All operations take O(1) expected time.
+
+@param Key   The type of the cache keys.
+@param Value The type of the cache values.
+@param Pred  A binary predicate that checks if two keys are equal.
+             If pred(a, b) == true, then key 'a' and key 'b' are
+             considered equal.
+@param Hash  A unary functor that computes the hash value of a key.
+*/
+template<typename Key, typename Value, typename Pred = std::equal_to<Key>,
+         typename Hash = Hasher<Key>>
+class LfuCache {
+public:
+    typedef std::size_t SizeType;
+    typedef std::function<void(const Key &key, const Value &val)> Callback;
+
+    struct Item {
+        Key key;
+        Value val;
+        SizeType freq;  // Use count
+    };
+
+    /*
+    Initialize an empty cache.
+
+    @param capacity_ The maximum amount of items in the cache. It is at least 1.
+    @param onEvict_  The function called with an item right before
+                     the item is evicted. It may be empty.
+    */
+    explicit LfuCache(const SizeType capacity_, const Callback &onEvict_ = Callback())
+        : capacity(capacity_ ? capacity_ : 1), onEvict(onEvict_),
+          table(capacity), groups(capacity) {}
+
+    LfuCache(const LfuCache &) = delete;
+    LfuCache& operator=(const LfuCache &) = delete;
+
+    /*
+    Return the amount of items in the cache.
+    */
+    SizeType getSize() const {
+        return items.getSize();
+    }
+
+    /*
+    Return the maximum amount of items in the cache.
+    */
+    SizeType getCapacity() const {
+        return capacity;
+    }
+
+    /*
+    Return true if the cache is empty.
+    */
+    bool isEmpty() const {
+        return items.isEmpty();
+    }
+
+    /*
+    Remove all items from the cache. The eviction callback is not called.
+    */
+    void clear() {
+        table.clear();
+        groups.clear();
+        items.clear();
+    }
+
+    /*
+    Check if a key is in the cache. Unlike get(),
+    it does not count as a use of the item.
+
+    @param key The key to be checked
+    */
+    bool has(const Key &key) const {
+        return table.find(probe(key)) != nullptr;
+    }
+
+    /*
+    Look up the value of a key and count a use of the item.
+
+    @param key The key to look up
+    @return    The pointer to the cached value. If the key is not in
+               the cache, return nullptr. The pointer stays valid until
+               the item is evicted or removed.
+    */
+    Value* get(const Key &key) {
+        Entry *e = table.find(probe(key));
+        if (!e) {
+            return nullptr;
+        }
+        touch(e->it);
+        return &e->it->val;
+    }
+
+    /*
+    Insert or update an item and count a use of it. If a new item
+    does not fit, the least frequently used item is evicted.
+
+    @param key The key of the item
+    @param val The value of the item
+    */
+    void put(const Key &key, const Value &val) {
+        Entry *e = table.find(probe(key));
+        if (e) {
+            e->it->val = val;
+            touch(e->it);
+            return;
+        }
+        if (items.getSize() == capacity) {
+            evict();
+        }
+        // The group of use count 1 is always the last one
+        Group *g = groups.find(Group{1, Iterator()});
+        auto it = items.insert(g ? g->first : items.end(), Item{key, val, 1});
+        if (g) {
+            g->first = it;
+        } else {
+            groups.insert(Group{1, it});
+        }
+        table.insert(Entry{&it->key, it});
+    }
+
+    /*
+    Remove an item from the cache. If the key doesn't exist,
+    this function does nothing. The eviction callback is not called.
+
+    @param key The key of the item to be removed
+    */
+    void remove(const Key &key) {
+        Entry *e = table.find(probe(key));
+        if (e) {
+            auto it = e->it;
+            table.remove(*e);
+            leaveGroup(it);
+            items.erase(it);
+        }
+    }
+
+private:
+    typedef typename DoublyLinkedList<Item>::Iterator Iterator;
+    typedef internal::CacheEntry<Key, Iterator> Entry;
+    typedef HashTable<Entry, internal::CacheEntryPred<Entry, Pred>,
+                      internal::CacheEntryHash<Entry, Hash>> Table;
+
+    /*
+    The items with the same use count are adjacent in the list,
+    from the most to the least recently used. 'first' is the
+    most recently used item of the group.
+    */
+    struct Group {
+        SizeType freq;
+        Iterator first;
+
+        bool operator==(const Group &g) const {
+            return freq == g.freq;
+        }
+    };
+
+    struct GroupHash {
+        std::size_t operator()(const Group &g) const {
+            return Hasher<SizeType>()(g.freq);
+        }
+    };
+
+    SizeType capacity;
+    Callback onEvict;
+    DoublyLinkedList<Item> items;  // From the most to the least frequently used
+    Table table;
+    HashTable<Group, std::equal_to<Group>, GroupHash> groups;
+
+    static Entry probe(const Key &key) {
+        return Entry{&key, Iterator()};
+    }
+
+    /*
+    Update the group of an item that is about to leave its position.
+    */
+    void leaveGroup(Iterator it) {
+        Group *g = groups.find(Group{it->freq, Iterator()});
+        if (g->first == it) {
+            auto next = it;
+            ++next;
+            if (next != items.end() && next->freq == it->freq) {
+                g->first = next;
+            } else {
+                groups.remove(*g);
+            }
+        }
+    }
+
+    /*
+    Count a use of an item and move it to the front of the next group.
+    */
+    void touch(Iterator it) {
+        Group *cur = groups.find(Group{it->freq, Iterator()});
+        Group *up = groups.find(Group{it->freq + 1, Iterator()});
+        // Without the next group, the item becomes a new group
+        // right before the front of its current group.
+        Iterator pos = (up ? up->first : cur->first);
+        leaveGroup(it);
+        if (pos != it) {
+            items.splice(pos, items, it);
+        }
+        ++it->freq;
+        up = groups.find(Group{it->freq, Iterator()});
+        if (up) {
+            up->first = it;
+        } else {
+            groups.insert(Group{it->freq, it});
+        }
+    }
+
+    /*
+    Evict the least frequently used item.
+    */
+    void evict() {
+        auto it = --items.end();
+        if (onEvict) {
+            onEvict(it->key, it->val);
+        }
+        table.remove(probe(it->key));
+        leaveGroup(it);
+        items.erase(it);
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef TASTYLIB_MINMAXHEAP_H_
+#define TASTYLIB_MINMAXHEAP_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/util/aligned_allocator.h"
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A double-ended priority queue taking the form of a complete binary tree,
+which is stored in an array in the same way as BinaryHeap.
+
+The levels of the tree alternate between min levels and max levels,
+starting with the root on a min level. A node on a min level is not
+larger than any of its descendants, and a node on a max level is not
+smaller than any of its descendants. So the minimum is the root and
+the maximum is one of its children.
+
+@param Value The type of the value stored in the heap
+@param Less  The type of the binary predicate to compare the values,
+             which is a strict weak ordering. By default it uses
+             operator '<'.
+*/
+template<typename Value, typename Less = std::less<Value>>
+class MinMaxHeap {
+public:
+    typedef std::vector<Value, AlignedAllocator<Value, 64, sizeof(Value)>> Container;
+    typedef typename Container::size_type SizeType;
+
+    /*
+    Destructor.
+    */
+    ~MinMaxHeap() {}
+
+    /*
+    Default constructor.
+    */
+    MinMaxHeap() {}
+
+    /*
+    Build a heap from the values in a range in O(n) time.
+
+    @param first The iterator to the first value
+    @param last  The iterator past the last value
+    */
+    template<typename InputIt>
+    MinMaxHeap(InputIt first, InputIt last) : tree(first, last) {
+        heapify();
+    }
+
+    /*
+    Return the amount of elements in the heap.
+    */
+    SizeType getSize() const {
+        return tree.size();
+    }
+
+    /*
+    Return true if the heap has no elements.
+    */
+    bool isEmpty() const {
+        return tree.empty();
+    }
+
+    /*
+    Clear the elements in the heap.
+    */
+    void clear() {
+        tree.clear();
+    }
+
+    /*
+    Insert a new element to the heap.
+
+    @param val The value of the element to be inserted
+    */
+    void push(const Value &val) {
+        tree.push_back(val);
+        bubbleUp(tree.size() - 1);
+    }
+
+    /*
+    Insert a new element to the heap. The value is moved into the heap.
+
+    @param val The value of the element to be inserted
+    */
+    void push(Value &&val) {
+        tree.push_back(std::move(val));
+        bubbleUp(tree.size() - 1);
+    }
+
+    /*
+    Insert a new element constructed in place from the given arguments.
+
+    @param args The arguments to construct the value
+    */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        tree.emplace_back(std::forward<Args>(args)...);
+        bubbleUp(tree.size() - 1);
+    }
+
+    /*
+    Return the smallest element.
+    Precondition: The heap is non-empty.
+    */
+    const Value& min() const {
+        return tree[ROOT];
+    }
+
+    /*
+    Return the largest element.
+    Precondition: The heap is non-empty.
+    */
+    const Value& max() const {
+        return tree[maxIndex()];
+    }
+
+    /*
+    Remove the smallest element.
+    Precondition: The heap is non-empty.
+    */
+    void popMin() {
+        removeAt(ROOT);
+    }
+
+    /*
+    Remove the largest element.
+    Precondition: The heap is non-empty.
+    */
+    void popMax() {
+        removeAt(maxIndex());
+    }
+
+    /*
+    Remove the smallest element and return it.
+    The value is moved out of the heap.
+    Precondition: The heap is non-empty.
+    */
+    Value popMinTop() {
+        Value res(std::move(tree[ROOT]));
+        removeAt(ROOT);
+        return res;
+    }
+
+    /*
+    Remove the largest element and return it.
+    The value is moved out of the heap.
+    Precondition: The heap is non-empty.
+    */
+    Value popMaxTop() {
+        const SizeType i = maxIndex();
+        Value res(std::move(tree[i]));
+        removeAt(i);
+        return res;
+    }
+
+private:
+    /*
+    Index of the root node in the tree array.
+    */
+    static const SizeType ROOT = 0;
+
+    Less less;
+
+    /*
+    Store the complete binary tree in an array named 'tree'. The root
+    is stored at tree[0]. For each node i in the tree:
+    1. tree[2 * i + 1] and tree[2 * i + 2] are the node values of its children.
+    2. tree[floor((i - 1) / 2)] is the node value of its parent.
+    3. Node i is on a min level if floor(log2(i + 1)) is even.
+    */
+    Container tree;
+
+    static SizeType parent(const SizeType i) {
+        return (i - 1) / 2;
+    }
+
+    static bool isMinLevel(const SizeType i) {
+#if defined(__GNUC__)
+        return __builtin_clzll((unsigned long long)i + 1) % 2 == 1;
+#else
+        SizeType level = 0;
+        for (SizeType x = i + 1; x > 1; x >>= 1) {
+            ++level;
+        }
+        return level % 2 == 0;
+#endif
+    }
+
+    /*
+    Return true if the value a should be nearer to the root than
+    the value b on a min level (IsMax == false) or on a max level
+    (IsMax == true).
+    */
+    template<bool IsMax>
+    bool before(const Value &a, const Value &b) const {
+        return IsMax ? less(b, a) : less(a, b);
+    }
+
+    /*
+    Return the index of the largest element.
+    Precondition: The heap is non-empty.
+    */
+    SizeType maxIndex() const {
+        if (tree.size() < 3) {
+            return tree.size() - 1;
+        }
+        return less(tree[1], tree[2]) ? 2 : 1;
+    }
+
+    /*
+    Remove the element at tree[i] by moving the last element there.
+    The removed element is always the root of its level kind, so
+    the moved element only needs to percolate down.
+    */
+    void removeAt(const SizeType i) {
+        if (i + 1 == tree.size()) {
+            tree.pop_back();
+            return;
+        }
+        tree[i] = std::move(tree.back());
+        tree.pop_back();
+        trickleDown(i);
+    }
+
+    /*
+    Percolate up the value at tree[i], which is a new leaf.
+    */
+    void bubbleUp(const SizeType i) {
+        if (i == ROOT) {
+            return;
+        }
+        const SizeType p = parent(i);
+        if (isMinLevel(i)) {
+            if (less(tree[p], tree[i])) {
+                std::swap(tree[i], tree[p]);
+                bubbleUpLevel<true>(p);
+            } else {
+                bubbleUpLevel<false>(i);
+            }
+        } else {
+            if (less(tree[i], tree[p])) {
+                std::swap(tree[i], tree[p]);
+                bubbleUpLevel<false>(p);
+            } else {
+                bubbleUpLevel<true>(i);
+            }
+        }
+    }
+
+    /*
+    Percolate up the value at tree[i] along its grandparents, which
+    are on the same level kind.
+    */
+    template<bool IsMax>
+    void bubbleUpLevel(SizeType i) {
+        if (i < 3 || !before<IsMax>(tree[i], tree[parent(parent(i))])) {
+            return;
+        }
+        Value val(std::move(tree[i]));
+        do {
+            const SizeType g = parent(parent(i));
+            tree[i] = std::move(tree[g]);
+            i = g;
+        } while (i >= 3 && before<IsMax>(val, tree[parent(parent(i))]));
+        tree[i] = std::move(val);
+    }
+
+    void trickleDown(const SizeType i) {
+        if (isMinLevel(i)) {
+            trickleDownLevel<false>(i);
+        } else {
+            trickleDownLevel<true>(i);
+        }
+    }
+
+    /*
+    Percolate down the value at tree[i] along the best of its children
+    and grandchildren. A value that moves to a grandchild is swapped
+    with the parent of that grandchild if it belongs to the other level
+    kind.
+    */
+    template<bool IsMax>
+    void trickleDownLevel(SizeType i) {
+        const SizeType end = tree.size();
+        while (2 * i + 1 < end) {
+            // The best among the children and grandchildren
+            const SizeType child = 2 * i + 1;
+            SizeType best = child;
+            if (child + 1 < end && before<IsMax>(tree[child + 1], tree[best])) {
+                best = child + 1;
+            }
+            const SizeType grand = 2 * child + 1;
+            const SizeType grandEnd = (grand + 4 < end ? grand + 4 : end);
+            for (SizeType k = grand; k < grandEnd; ++k) {
+                best = (before<IsMax>(tree[k], tree[best]) ? k : best);
+            }
+            if (!before<IsMax>(tree[best], tree[i])) {
+                return;
+            }
+            std::swap(tree[i], tree[best]);
+            if (best < grand) {  // A child is a leaf of the other level kind
+                return;
+            }
+            const SizeType p = parent(best);
+            if (before<IsMax>(tree[p], tree[best])) {
+                std::swap(tree[p], tree[best]);
+            }
+            i = best;
+        }
+    }
+
+    /*
+    Rebuild the heap order of the whole tree in O(n) time
+    by percolating down each internal node from the last one.
+    */
+    void heapify() {
+        if (tree.size() < 2) {
+            return;
+        }
+        for (SizeType i = parent(tree.size() - 1) + 1; i-- > ROOT;) {
+            trickleDown(i);
+        }
+    }
+};
+
+template<typename Value, typename Less>
+const typename MinMaxHeap<Value, Less>::SizeType MinMaxHeap<Value, Less>::ROOT;
+
+TASTYLIB_NS_END
+
+#endif
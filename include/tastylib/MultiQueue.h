@@ -0,0 +1,226 @@
+#ifndef TASTYLIB_MULTIQUEUE_H_
+#define TASTYLIB_MULTIQUEUE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/BinaryHeap.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <cstdint>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A relaxed priority queue for multiple threads, made of c * T BinaryHeaps
+each guarded by its own spin lock, where T is the amount of threads.
+A push goes to a random heap whose lock is free. A pop locks two random
+heaps and removes the better of their roots. Threads rarely touch the
+same heap, so the throughput scales with the amount of threads, while
+the popped elements stay close to the priority order: the expected rank
+of a popped element among all elements is O(c * T).
+
+@param Value The type of the value stored in the queue
+@param Pred  The type of the binary predicate to arrange the elements,
+             the same as BinaryHeap. By default it uses operator '>=',
+             which makes the queue pop the smallest elements first.
+*/
+template<typename Value, typename Pred = std::greater_equal<Value>>
+class MultiQueue {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    Initialize an empty queue.
+
+    @param threadNum The amount of threads that use the queue
+    @param c         The amount of heaps per thread. A larger value
+                     reduces lock conflicts but pops elements further
+                     from the priority order.
+    */
+    explicit MultiQueue(const SizeType threadNum, const SizeType c = 2)
+        : heapNum(threadNum * c > 2 ? threadNum * c : 2), slots(new Slot[heapNum]) {
+        for (SizeType i = 0; i < heapNum; ++i) {
+            slots[i].locked.store(false, std::memory_order_relaxed);
+            slots[i].size.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /*
+    Destructor. It must not run concurrently with other operations.
+    */
+    ~MultiQueue() {
+        delete[] slots;
+    }
+
+    MultiQueue(const MultiQueue &) = delete;
+    MultiQueue& operator=(const MultiQueue &) = delete;
+
+    /*
+    Return the amount of internal heaps.
+    */
+    SizeType getHeapCount() const {
+        return heapNum;
+    }
+
+    /*
+    Return the amount of elements in the queue. The result
+    is approximate while other threads modify the queue.
+    */
+    SizeType getSize() const {
+        SizeType sum = 0;
+        for (SizeType i = 0; i < heapNum; ++i) {
+            sum += slots[i].size.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /*
+    Return true if the queue is empty. The result is
+    approximate while other threads modify the queue.
+    */
+    bool isEmpty() const {
+        return getSize() == 0;
+    }
+
+    /*
+    Insert a new element to a random heap.
+
+    @param val The value of the element to be inserted
+    */
+    void push(const Value &val) {
+        SlotGuard guard(lockRandom());
+        guard.s.heap.push(val);
+    }
+
+    /*
+    Insert a new element to a random heap.
+    The value is moved into the queue.
+
+    @param val The value of the element to be inserted
+    */
+    void push(Value &&val) {
+        SlotGuard guard(lockRandom());
+        guard.s.heap.push(std::move(val));
+    }
+
+    /*
+    Remove the better of the root elements of two random heaps.
+
+    @param val Output. The removed value.
+    @return    True if an element is removed, false if the queue is
+               empty. It may return false while another thread is
+               inserting the first element.
+    */
+    bool tryPop(Value &val) {
+        while (true) {
+            SizeType i = randIndex(heapNum);
+            SizeType j = randIndex(heapNum - 1);
+            j += (j >= i);
+            Slot *a = &slots[i], *b = &slots[j];
+            if (isEmpty(*a) && isEmpty(*b)) {
+                if (isEmpty()) {
+                    return false;
+                }
+                continue;
+            }
+            if (!tryLock(*a)) {
+                continue;
+            }
+            SlotGuard guardA(*a);
+            if (!tryLock(*b)) {
+                continue;
+            }
+            SlotGuard guardB(*b);
+            if (b->heap.isEmpty() || (!a->heap.isEmpty() && pred(b->heap.top(), a->heap.top()))) {
+                std::swap(a, b);
+            }
+            // Now 'b' holds the better root, if any
+            if (!b->heap.isEmpty()) {
+                val = b->heap.popTop();
+                return true;
+            }
+        }
+    }
+
+private:
+    /*
+    Size of a cache line. The locks of different
+    heaps are padded to different cache lines.
+    */
+    static const SizeType CACHE_LINE = 64;
+
+    struct Slot {
+        std::atomic<bool> locked;
+        std::atomic<SizeType> size;  // Size of the heap for lock-free checks
+        BinaryHeap<Value, Pred> heap;
+        char pad[CACHE_LINE];
+    };
+
+    SizeType heapNum;
+    Slot *slots;
+    Pred pred;
+
+    /*
+    Return a random number in [0, n) from a
+    xorshift generator owned by the calling thread.
+    */
+    static SizeType randIndex(const SizeType n) {
+        thread_local std::uint64_t state =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) * 0x9E3779B97F4A7C15ull | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return (SizeType)(((state >> 32) * n) >> 32);
+    }
+
+    static bool isEmpty(const Slot &s) {
+        return s.size.load(std::memory_order_relaxed) == 0;
+    }
+
+    static bool tryLock(Slot &s) {
+        return !s.locked.load(std::memory_order_relaxed)
+               && !s.locked.exchange(true, std::memory_order_acquire);
+    }
+
+    static void unlock(Slot &s) {
+        s.size.store(s.heap.getSize(), std::memory_order_relaxed);
+        s.locked.store(false, std::memory_order_release);
+    }
+
+    /*
+    Take over a locked heap and unlock it at the end of the scope, so
+    that an exception thrown by the values or the predicate cannot
+    leave the heap locked.
+    */
+    struct SlotGuard {
+        Slot &s;
+
+        explicit SlotGuard(Slot &s_) : s(s_) {}
+
+        ~SlotGuard() {
+            unlock(s);
+        }
+
+        SlotGuard(const SlotGuard &) = delete;
+        SlotGuard& operator=(const SlotGuard &) = delete;
+    };
+
+    /*
+    Lock a random heap, trying other heaps when the chosen one is locked.
+    */
+    Slot& lockRandom() {
+        while (true) {
+            Slot &s = slots[randIndex(heapNum)];
+            if (tryLock(s)) {
+                return s;
+            }
+        }
+    }
+};
+
+template<typename Value, typename Pred>
+const typename MultiQueue<Value, Pred>::SizeType MultiQueue<Value, Pred>::CACHE_LINE;
+
+TASTYLIB_NS_END
+
+#endif
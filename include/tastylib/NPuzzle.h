@@ -4,8 +4,9 @@
 #include "tastylib/internal/base.h"
 #include "tastylib/util/random.h"
 #include "tastylib/util/swap.h"
+#include "tastylib/Hash.h"
 #include "tastylib/HashTable.h"
-#include "tastylib/BinaryHeap.h"
+#include "tastylib/AddressableHeap.h"
 #include <vector>
 #include <sstream>
 #include <string>
@@ -198,7 +199,7 @@ public:
     Return the hash value of the node.
     */
     SizeType hash() const {
-        return std::hash<std::string>()(toString());
+        return (SizeType)hashBytes(val.data(), val.size() * sizeof(Int));
     }
 
     /*
@@ -329,7 +330,7 @@ public:
     @param des_ The ending node
     */
     NPuzzle(const Node &beg_, const Node &end_)
-        : beg(beg_), end(end_), closeList(1000000) {}
+        : beg(beg_), end(end_) {}
 
     /*
     Solve the problem using A* searching.
@@ -337,21 +338,13 @@ public:
     void solve() {
         std::vector<SizeType> index = buildIndex();
         searchCnt = 0;
-        openList.push(&beg);
+        openTable.insert(OpenEntry{&beg, openList.push(&beg)});
+        // If the open list becomes empty, then there is
+        // no available path between the two nodes.
         while (!openList.isEmpty()) {
-            Node *cur = nullptr;
-            do {
-                // Loop until the open list is empty or a node
-                // that is not in the close list is found.
-                cur = openList.top();
-                openList.pop();
-            } while (!openList.isEmpty() && closeList.has(cur));
-            if (openList.isEmpty() && closeList.has(cur)) {
-                // If all the nodes in the open list is in the
-                // close list, then there is no available path
-                // between the two nodes.
-                return;
-            }
+            Node *cur = openList.top();
+            openList.pop();
+            openTable.remove(OpenEntry{cur, 0});
             ++searchCnt;
             closeList.insert(cur);
             if (*cur == end) {
@@ -367,8 +360,17 @@ public:
                     if (!closeList.has(adj)) {
                         adj->setParent(cur);
                         adj->setG(cur->getG() + 1);
-                        adj->setH(adj->heuristic(&end, index));
-                        openList.push(adj);
+                        OpenEntry *e = openTable.find(OpenEntry{adj, 0});
+                        if (!e) {
+                            adj->setH(adj->heuristic(&end, index));
+                            openTable.insert(OpenEntry{adj, openList.push(adj)});
+                        } else if (adj->getG() < e->node->getG()) {
+                            // A shorter path to a node in the open list
+                            // is found, so the node moves toward the root
+                            adj->setH(e->node->getH());
+                            openList.decreaseKey(e->handle, adj);
+                            e->node = adj;
+                        }
                     }
                 }
             }
@@ -446,10 +448,33 @@ private:
         }
     };
 
+    typedef AddressableHeap<Node*, GreaterEqual> OpenList;
+
+    /*
+    A node in the open list and its handle in the heap.
+    */
+    struct OpenEntry {
+        Node *node;
+        typename OpenList::Handle handle;
+    };
+
+    struct OpenEqual {
+        bool operator()(const OpenEntry &e1, const OpenEntry &e2) const {
+            return *e1.node == *e2.node;
+        }
+    };
+
+    struct OpenHash {
+        SizeType operator()(const OpenEntry &e) const {
+            return e.node->hash();
+        }
+    };
+
     Node beg;
     Node end;
 
-    BinaryHeap<Node*, GreaterEqual> openList;
+    OpenList openList;
+    HashTable<OpenEntry, OpenEqual, OpenHash> openTable;  // Nodes in the open list
     HashTable<Node*, Equal, Hash> closeList;
 
     std::list<Direction> path;
@@ -495,6 +520,7 @@ private:
         }
         alloc.clear();
         openList.clear();
+        openTable.clear();
         closeList.clear();
     }
 };
@@ -0,0 +1,428 @@
+#ifndef TASTYLIB_PAIRINGHEAP_H_
+#define TASTYLIB_PAIRINGHEAP_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <new>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A heap-ordered multiway tree that restructures itself only when the
+root is removed. Two heaps are melded by linking their roots, and an
+element whose value moves toward the root is cut from its parent and
+linked with the root, so push(), meld() and decreaseKey() take O(1)
+time while pop() and erase() take O(logn) amortized time.
+
+The nodes are allocated from chunks owned by the heap. Removed nodes
+are reused by later insertions, and meld() hands the chunks of the
+other heap over to this heap, so no element is copied or reallocated.
+
+@param Value The type of the value stored in the heap
+@param Pred  The type of the binary predicate to arrange tree the nodes.
+             The heap ensures that for each node N in the tree,
+             N.value == N.parent.value OR Pred(N.value, N.parent.value) == true.
+             By default it uses operator '>=' as the predicate, which makes it
+             a min-root heap.
+*/
+template<typename Value, typename Pred = std::greater_equal<Value>>
+class PairingHeap {
+private:
+    struct Node;
+
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    The handle of an element. It stays valid until the element is
+    popped or erased, including after the heap is melded into another.
+    */
+    typedef Node* Handle;
+
+    /*
+    The amount of nodes allocated at once.
+    */
+    static const SizeType CHUNK_SIZE = 256;
+
+    /*
+    Destructor.
+    */
+    ~PairingHeap() {
+        clear();
+    }
+
+    /*
+    Default constructor.
+    */
+    PairingHeap()
+        : size(0), root(nullptr), chunks(nullptr), chunksTail(nullptr),
+          freeNodes(nullptr), freeTail(nullptr) {}
+
+    PairingHeap(const PairingHeap &) = delete;
+    PairingHeap& operator=(const PairingHeap &) = delete;
+
+    /*
+    Return the amount of elements in the heap.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the heap has no elements.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Remove all elements and release the memory of the nodes.
+    All handles become invalid.
+    */
+    void clear() {
+        if (!std::is_trivially_destructible<Value>::value && root) {
+            std::vector<Node*> stack(1, root);
+            while (!stack.empty()) {
+                Node *n = stack.back();
+                stack.pop_back();
+                for (Node *c = n->child; c; c = c->next) {
+                    stack.push_back(c);
+                }
+                n->~Node();
+            }
+        }
+        while (chunks) {
+            Chunk *next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+        size = 0;
+        root = nullptr;
+        chunksTail = nullptr;
+        freeNodes = freeTail = nullptr;
+    }
+
+    /*
+    Insert a new element to the heap in O(1) time.
+
+    @param val The value of the element to be inserted
+    @return    The handle of the new element
+    */
+    Handle push(const Value &val) {
+        return insert(val);
+    }
+
+    /*
+    Insert a new element to the heap in O(1) time.
+    The value is moved into the heap.
+
+    @param val The value of the element to be inserted
+    @return    The handle of the new element
+    */
+    Handle push(Value &&val) {
+        return insert(std::move(val));
+    }
+
+    /*
+    Insert a new element constructed in place from the given arguments.
+
+    @param args The arguments to construct the value
+    @return     The handle of the new element
+    */
+    template<typename... Args>
+    Handle emplace(Args&&... args) {
+        return insert(std::forward<Args>(args)...);
+    }
+
+    /*
+    Return the root element of the heap.
+    Precondition: The heap is non-empty.
+    */
+    const Value& top() const {
+        return root->val;
+    }
+
+    /*
+    Return the handle of the root element.
+    Precondition: The heap is non-empty.
+    */
+    Handle topHandle() const {
+        return root;
+    }
+
+    /*
+    Return the value of an element.
+
+    @param h The handle of the element
+    */
+    const Value& get(const Handle h) const {
+        return h->val;
+    }
+
+    /*
+    Remove the root element of the heap in O(logn) amortized time.
+    Precondition: The heap is non-empty.
+    */
+    void pop() {
+        Node *old = root;
+        root = mergePairs(old->child);
+        release(old);
+    }
+
+    /*
+    Remove the root element of the heap and return it.
+    The value is moved out of the heap.
+    Precondition: The heap is non-empty.
+    */
+    Value popTop() {
+        Value res(std::move(root->val));
+        pop();
+        return res;
+    }
+
+    /*
+    Remove an element from the heap in O(logn) amortized time.
+
+    @param h The handle of the element
+    */
+    void erase(const Handle h) {
+        if (h == root) {
+            pop();
+            return;
+        }
+        cut(h);
+        Node *sub = mergePairs(h->child);
+        if (sub) {
+            root = link(root, sub);
+        }
+        release(h);
+    }
+
+    /*
+    Change the value of an element to one that moves it toward the
+    root, e.g. a smaller value in a min-root heap. It takes O(1) time.
+
+    @param h   The handle of the element
+    @param val The new value. Pred(old value, val) must be true.
+    @return    False if the new value violates the precondition,
+               and nothing is changed.
+    */
+    bool decreaseKey(const Handle h, const Value &val) {
+        if (!pred(h->val, val)) {
+            return false;
+        }
+        h->val = val;
+        if (h != root) {
+            cut(h);
+            root = link(root, h);
+        }
+        return true;
+    }
+
+    /*
+    Move all elements of another heap into this heap in O(1) time. The
+    other heap becomes empty, and the handles of its elements refer to
+    the same elements in this heap.
+
+    @param other The heap to be melded
+    */
+    void meld(PairingHeap &other) {
+        if (&other == this) {
+            return;
+        }
+        if (other.root) {
+            root = (root ? link(root, other.root) : other.root);
+        }
+        size += other.size;
+        if (other.chunks) {
+            other.chunksTail->next = chunks;
+            chunks = other.chunks;
+            chunksTail = (chunksTail ? chunksTail : other.chunksTail);
+        }
+        if (other.freeNodes) {
+            other.freeTail->next = freeNodes;
+            freeNodes = other.freeNodes;
+            freeTail = (freeTail ? freeTail : other.freeTail);
+        }
+        other.size = 0;
+        other.root = nullptr;
+        other.chunks = other.chunksTail = nullptr;
+        other.freeNodes = other.freeTail = nullptr;
+    }
+
+private:
+    /*
+    A node of the tree. The children of a node form a list linked
+    by 'next', and 'prev' is the previous sibling of the node, or
+    its parent if the node is the first child.
+    */
+    struct Node {
+        Value val;
+        Node *child;
+        Node *next;
+        Node *prev;
+
+        template<typename... Args>
+        explicit Node(Args&&... args)
+            : val(std::forward<Args>(args)...), child(nullptr), next(nullptr), prev(nullptr) {}
+    };
+
+    /*
+    The header of a chunk, which is followed by CHUNK_SIZE nodes.
+    */
+    struct alignas(Node) Chunk {
+        Chunk *next;
+    };
+
+    /*
+    A free node. It is linked to the next free
+    node through the memory of its value.
+    */
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    SizeType size;
+    Pred pred;
+    Node *root;
+    Chunk *chunks;       // All chunks owned by the heap
+    Chunk *chunksTail;
+    FreeNode *freeNodes;  // Head of the free node pool
+    FreeNode *freeTail;
+
+    /*
+    Construct a node from the free node pool
+    and link it with the root.
+    */
+    template<typename... Args>
+    Node* insert(Args&&... args) {
+        if (!freeNodes) {
+            allocChunk();
+        }
+        FreeNode *f = freeNodes;
+        freeNodes = f->next;
+        if (!freeNodes) {
+            freeTail = nullptr;
+        }
+        Node *n = new (f) Node(std::forward<Args>(args)...);
+        root = (root ? link(root, n) : n);
+        ++size;
+        return n;
+    }
+
+    /*
+    Destroy a node and put it back to the free node pool.
+    */
+    void release(Node *n) {
+        n->~Node();
+        FreeNode *f = reinterpret_cast<FreeNode*>(n);
+        f->next = freeNodes;
+        freeNodes = f;
+        if (!freeTail) {
+            freeTail = f;
+        }
+        --size;
+    }
+
+    /*
+    Allocate a chunk and put its nodes to the free node pool in
+    address order, so consecutive insertions use adjacent memory.
+    */
+    void allocChunk() {
+        Chunk *c = static_cast<Chunk*>(::operator new(sizeof(Chunk) + CHUNK_SIZE * sizeof(Node)));
+        c->next = chunks;
+        chunks = c;
+        if (!chunksTail) {
+            chunksTail = c;
+        }
+        Node *nodes = reinterpret_cast<Node*>(c + 1);
+        for (SizeType i = 0; i < CHUNK_SIZE; ++i) {
+            reinterpret_cast<FreeNode*>(nodes + i)->next =
+                (i + 1 < CHUNK_SIZE ? reinterpret_cast<FreeNode*>(nodes + i + 1) : freeNodes);
+        }
+        if (!freeNodes) {
+            freeTail = reinterpret_cast<FreeNode*>(nodes + CHUNK_SIZE - 1);
+        }
+        freeNodes = reinterpret_cast<FreeNode*>(nodes);
+    }
+
+    /*
+    Link two trees and return the root of the result. The root
+    with the worse value becomes the first child of the other one.
+    The 'next' and 'prev' links of the returned root are unchanged.
+    */
+    Node* link(Node *a, Node *b) {
+        if (!pred(b->val, a->val)) {
+            std::swap(a, b);
+        }
+        b->next = a->child;
+        if (a->child) {
+            a->child->prev = b;
+        }
+        b->prev = a;
+        a->child = b;
+        return a;
+    }
+
+    /*
+    Detach a non-root node, together with its subtree, from its parent.
+    */
+    void cut(Node *n) {
+        if (n->prev->child == n) {
+            n->prev->child = n->next;
+        } else {
+            n->prev->next = n->next;
+        }
+        if (n->next) {
+            n->next->prev = n->prev;
+        }
+        n->next = n->prev = nullptr;
+    }
+
+    /*
+    Combine a list of sibling trees into one tree with the two-pass
+    pairing: link the trees in pairs from left to right, and then
+    link the results from right to left.
+
+    @param first The first tree of the list
+    @return      The root of the combined tree, or nullptr
+                 if the list is empty.
+    */
+    Node* mergePairs(Node *first) {
+        if (!first) {
+            return nullptr;
+        }
+        Node *pairs = nullptr;  // Results of the first pass in reversed order
+        while (first) {
+            Node *a = first, *b = first->next;
+            if (!b) {
+                a->next = pairs;
+                pairs = a;
+                break;
+            }
+            first = b->next;
+            Node *w = link(a, b);
+            w->next = pairs;
+            pairs = w;
+        }
+        Node *res = pairs;
+        pairs = pairs->next;
+        while (pairs) {
+            Node *next = pairs->next;
+            res = link(res, pairs);
+            pairs = next;
+        }
+        res->next = res->prev = nullptr;
+        return res;
+    }
+};
+
+template<typename Value, typename Pred>
+const typename PairingHeap<Value, Pred>::SizeType PairingHeap<Value, Pred>::CHUNK_SIZE;
+
+TASTYLIB_NS_END
+
+#endif
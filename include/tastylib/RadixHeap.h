@@ -0,0 +1,250 @@
+#ifndef TASTYLIB_RADIXHEAP_H_
+#define TASTYLIB_RADIXHEAP_H_
+
+#include "tastylib/internal/base.h"
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A min-root priority queue for monotone integer keys, that is, no key
+pushed is smaller than the last popped key. This is the case of the
+distances in Dijkstra's algorithm and the times in event simulations.
+
+The elements are kept in buckets by the highest bit in which their
+keys differ from the last popped key. Bucket 0 holds the keys equal
+to it, and bucket i holds the keys that differ from it first at bit
+i - 1. A pop that finds bucket 0 empty takes the first non-empty
+bucket, makes its minimum key the new reference, and moves its other
+elements to lower buckets. An element only moves to lower buckets, so
+push() and pop() take O(logC) amortized time without any comparison
+between elements, where C is the range of the keys.
+
+@param Key   The type of the keys, which is a signed or unsigned integer
+@param Value The type of the values stored with the keys
+*/
+template<typename Key, typename Value>
+class RadixHeap {
+public:
+    static_assert(std::is_integral<Key>::value, "The key of RadixHeap must be an integer.");
+
+    typedef std::size_t SizeType;
+    typedef std::pair<Key, Value> Item;
+
+    /*
+    Destructor.
+    */
+    ~RadixHeap() {}
+
+    /*
+    Default constructor.
+    */
+    RadixHeap() : size(0), last(0) {}
+
+    /*
+    Return the amount of elements in the heap.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the heap has no elements.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Remove all elements. Any key can be pushed afterwards.
+    */
+    void clear() {
+        for (SizeType i = 0; i < BUCKET_NUM; ++i) {
+            buckets[i].clear();
+        }
+        size = 0;
+        last = 0;
+    }
+
+    /*
+    Return the smallest key that can be pushed, which is
+    the last popped key or the smallest key of the type.
+    */
+    Key getMinPushKey() const {
+        return toKey(last);
+    }
+
+    /*
+    Insert a new element to the heap.
+
+    @param key The key of the element
+    @param val The value of the element
+    @return    False if the key is smaller than the last popped
+               key, and the element is not inserted.
+    */
+    bool push(const Key key, const Value &val) {
+        UKey u = toUKey(key);
+        if (u < last) {
+            return false;
+        }
+        buckets[bucketOf(u)].emplace_back(key, val);
+        ++size;
+        return true;
+    }
+
+    /*
+    Insert a new element to the heap. The value is moved into the heap.
+
+    @param key The key of the element
+    @param val The value of the element
+    @return    False if the key is smaller than the last popped
+               key, and the element is not inserted.
+    */
+    bool push(const Key key, Value &&val) {
+        UKey u = toUKey(key);
+        if (u < last) {
+            return false;
+        }
+        buckets[bucketOf(u)].emplace_back(key, std::move(val));
+        ++size;
+        return true;
+    }
+
+    /*
+    Return the element with the smallest key. If bucket 0 is empty,
+    the first non-empty bucket is scanned for the smallest key.
+    Precondition: The heap is non-empty.
+    */
+    const Item& top() const {
+        if (!buckets[0].empty()) {
+            return buckets[0].back();
+        }
+        const std::vector<Item> &b = buckets[firstBucket()];
+        SizeType best = 0;
+        for (SizeType i = 1; i < b.size(); ++i) {
+            if (b[i].first < b[best].first) {
+                best = i;
+            }
+        }
+        return b[best];
+    }
+
+    /*
+    Remove the element with the smallest key.
+    Precondition: The heap is non-empty.
+    */
+    void pop() {
+        pull();
+        buckets[0].pop_back();
+        --size;
+    }
+
+    /*
+    Remove the element with the smallest key and return it.
+    The element is moved out of the heap.
+    Precondition: The heap is non-empty.
+    */
+    Item popTop() {
+        pull();
+        Item res(std::move(buckets[0].back()));
+        buckets[0].pop_back();
+        --size;
+        return res;
+    }
+
+private:
+    /*
+    Keys are mapped to unsigned integers of the same width in an
+    order-preserving way by flipping the sign bit of signed keys.
+    */
+    typedef typename std::make_unsigned<Key>::type UKey;
+
+    static const SizeType KEY_BITS = std::numeric_limits<UKey>::digits;
+    static const SizeType BUCKET_NUM = KEY_BITS + 1;
+    static const UKey SIGN_FLIP = (std::is_signed<Key>::value ? (UKey)1 << (KEY_BITS - 1) : 0);
+
+    SizeType size;
+    UKey last;  // The reference key, which is the last popped key
+    std::vector<Item> buckets[BUCKET_NUM];
+
+    static UKey toUKey(const Key key) {
+        return (UKey)key ^ SIGN_FLIP;
+    }
+
+    static Key toKey(const UKey u) {
+        return (Key)(u ^ SIGN_FLIP);
+    }
+
+    /*
+    Return the amount of bits needed to represent a positive integer.
+    */
+    static SizeType bitWidth(const UKey x) {
+#if defined(__GNUC__)
+        return 64 - __builtin_clzll((unsigned long long)x);
+#else
+        SizeType w = 0;
+        for (UKey y = x; y; y >>= 1) {
+            ++w;
+        }
+        return w;
+#endif
+    }
+
+    /*
+    Return the bucket of a key, which is not smaller than the reference key.
+    */
+    SizeType bucketOf(const UKey u) const {
+        return u == last ? 0 : bitWidth(u ^ last);
+    }
+
+    /*
+    Return the index of the first non-empty bucket.
+    Precondition: The heap is non-empty.
+    */
+    SizeType firstBucket() const {
+        SizeType i = 0;
+        while (buckets[i].empty()) {
+            ++i;
+        }
+        return i;
+    }
+
+    /*
+    Make sure bucket 0 is non-empty. If it is empty, the smallest key
+    of the first non-empty bucket becomes the reference key, and the
+    elements of that bucket are moved to lower buckets.
+    Precondition: The heap is non-empty.
+    */
+    void pull() {
+        if (!buckets[0].empty()) {
+            return;
+        }
+        std::vector<Item> &b = buckets[firstBucket()];
+        UKey minKey = toUKey(b[0].first);
+        for (SizeType i = 1; i < b.size(); ++i) {
+            UKey u = toUKey(b[i].first);
+            minKey = (u < minKey ? u : minKey);
+        }
+        last = minKey;
+        for (auto &item : b) {
+            buckets[bucketOf(toUKey(item.first))].push_back(std::move(item));
+        }
+        b.clear();
+    }
+};
+
+template<typename Key, typename Value>
+const typename RadixHeap<Key, Value>::SizeType RadixHeap<Key, Value>::KEY_BITS;
+
+template<typename Key, typename Value>
+const typename RadixHeap<Key, Value>::SizeType RadixHeap<Key, Value>::BUCKET_NUM;
+
+template<typename Key, typename Value>
+const typename RadixHeap<Key, Value>::UKey RadixHeap<Key, Value>::SIGN_FLIP;
+
+TASTYLIB_NS_END
+
+#endif
@@ -5,6 +5,7 @@
 #include "tastylib/util/swap.h"
 #include "tastylib/BinaryHeap.h"
 #include <functional>
+#include <iterator>
 
 TASTYLIB_NS_BEGIN
 
@@ -60,13 +61,9 @@ The heapsort algorithm to sort an unordered array.
 */
 template<typename Ele, typename Pred = std::greater_equal<Ele>>
 void heapSort(Ele *const arr, const std::size_t n) {
-    BinaryHeap<Ele, Pred> heap;
+    BinaryHeap<Ele, Pred> heap(std::make_move_iterator(arr), std::make_move_iterator(arr + n));
     for (std::size_t i = 0; i < n; ++i) {
-        heap.push(arr[i]);
-    }
-    for (std::size_t i = 0; i < n; ++i) {
-        arr[i] = heap.top();
-        heap.pop();
+        arr[i] = heap.popTop();
     }
 }
 
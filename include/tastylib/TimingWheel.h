@@ -0,0 +1,451 @@
+#ifndef TASTYLIB_TIMINGWHEEL_H_
+#define TASTYLIB_TIMINGWHEEL_H_
+
+#include "tastylib/internal/base.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A hierarchical timing wheel, which is a timer queue with O(1) schedule()
+and cancel() for timers that are often cancelled before they expire.
+
+There are 4 levels of 256 slots. A slot of level k covers 256^k ticks,
+so the levels cover 2^32 ticks, and timers expiring later than that are
+kept in an overflow list. Each slot holds a doubly linked list of timers
+whose nodes are pooled in an array and linked by indices. When the time
+reaches the start of a slot of a higher level, the timers in that slot
+are moved down to lower levels. The slots of level 0 hold the timers
+expiring in the next 256 ticks, and the timers of a slot are fired in a
+batch when the time reaches it.
+
+@param Value The type of the value stored with each timer,
+             which is default constructible
+*/
+template<typename Value>
+class TimingWheel {
+public:
+    typedef std::size_t SizeType;
+    typedef std::uint64_t Time;
+
+    /*
+    The handle of a timer, which combines the index of its node and a
+    generation number. It becomes invalid when the timer is fired or
+    cancelled, even if the node is reused by another timer.
+    */
+    typedef std::uint64_t Handle;
+
+    /*
+    Destructor.
+    */
+    ~TimingWheel() {}
+
+    /*
+    Initialize the timing wheel.
+
+    @param start The initial time
+    */
+    explicit TimingWheel(const Time start = 0)
+        : time(start), size(0), freeNodes(NIL), epoch(0), heads(SLOT_NUM, NIL) {
+        for (SizeType i = 0; i < LEVEL_NUM * BITMAP_WORDS; ++i) {
+            bitmap[i] = 0;
+        }
+    }
+
+    /*
+    Return the amount of pending timers.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if there is no pending timer.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Return the current time, until which all expired timers have fired.
+    */
+    Time getTime() const {
+        return time;
+    }
+
+    /*
+    Remove all pending timers and release the memory of the nodes.
+    All handles become invalid. The current time is not changed.
+    */
+    void clear() {
+        // Handles of the old nodes never match the new nodes
+        for (const auto &n : nodes) {
+            epoch = (n.gen >= epoch ? n.gen + 1 : epoch);
+        }
+        nodes.clear();
+        heads.assign(SLOT_NUM, NIL);
+        for (SizeType i = 0; i < LEVEL_NUM * BITMAP_WORDS; ++i) {
+            bitmap[i] = 0;
+        }
+        freeNodes = NIL;
+        size = 0;
+    }
+
+    /*
+    Schedule a timer in O(1) time. A timer that expires no later than
+    the current time fires at the next tick.
+
+    @param expire The expiration time
+    @param val    The value of the timer
+    @return       The handle of the timer.
+    */
+    Handle schedule(const Time expire, const Value &val) {
+        Index i = allocate();
+        nodes[i].val = val;
+        return place(i, expire);
+    }
+
+    /*
+    Schedule a timer in O(1) time. The value is moved into the wheel.
+
+    @param expire The expiration time
+    @param val    The value of the timer
+    @return       The handle of the timer.
+    */
+    Handle schedule(const Time expire, Value &&val) {
+        Index i = allocate();
+        nodes[i].val = std::move(val);
+        return place(i, expire);
+    }
+
+    /*
+    Return true if a handle refers to a pending timer.
+    */
+    bool contains(const Handle h) const {
+        const Index i = indexOf(h);
+        return i < nodes.size() && nodes[i].slot != NIL && nodes[i].gen == genOf(h);
+    }
+
+    /*
+    Cancel a pending timer in O(1) time.
+
+    @param h The handle of the timer
+    @return  False if the handle does not refer to a pending timer.
+    */
+    bool cancel(const Handle h) {
+        if (!contains(h)) {
+            return false;
+        }
+        const Index i = indexOf(h);
+        unlink(i);
+        release(i);
+        return true;
+    }
+
+    /*
+    Advance the time and fire the expired timers in the order of their
+    slots. A timer may be scheduled or cancelled in the callback. The
+    ticks at which no slot needs to be visited are skipped by the bitmaps
+    of the non-empty slots.
+
+    @param now The new time, which is not earlier than the current time
+    @param cb  The callback called with the value of each fired timer
+    @return    The amount of fired timers.
+    */
+    template<typename Callback>
+    SizeType advance(const Time now, Callback cb) {
+        SizeType fired = 0;
+        while (time < now) {
+            if (size == 0) {
+                time = now;
+                break;
+            }
+            const Time tick = nextTick(time + 1);
+            if (tick > now) {
+                time = now;
+                break;
+            }
+            time = tick - 1;
+            if ((tick & SLOT_MASK) == 0) {
+                cascade(tick);
+            }
+            time = tick;
+            const SizeType s = (SizeType)(tick & SLOT_MASK);
+            if (heads[s] != NIL) {
+                fired += fire(s, cb);
+            }
+        }
+        return fired;
+    }
+
+private:
+    typedef std::uint32_t Index;
+
+    static const Index NIL = (Index)-1;
+    static const SizeType LEVEL_NUM = 4;
+    static const SizeType LEVEL_BITS = 8;
+    static const SizeType SLOTS_PER_LEVEL = 1 << LEVEL_BITS;
+    static const Time SLOT_MASK = SLOTS_PER_LEVEL - 1;
+    static const Index OVERFLOW_SLOT = LEVEL_NUM * SLOTS_PER_LEVEL;
+    static const Index FIRING_SLOT = OVERFLOW_SLOT + 1;  // Timers being fired
+    static const SizeType SLOT_NUM = FIRING_SLOT + 1;
+    static const SizeType BITMAP_WORDS = SLOTS_PER_LEVEL / 64;  // Per level
+
+    struct Node {
+        Value val;
+        Time expire;
+        Index prev;
+        Index next;
+        Index slot;  // NIL if the node is free
+        Index gen;
+    };
+
+    Time time;
+    SizeType size;
+    Index freeNodes;  // Free nodes linked by 'next'
+    Index epoch;      // The first generation of new nodes
+    std::vector<Node> nodes;
+    std::vector<Index> heads;  // The first node of each slot
+    std::uint64_t bitmap[LEVEL_NUM * BITMAP_WORDS];  // Non-empty slots of the levels
+
+    static Index indexOf(const Handle h) {
+        return (Index)h;
+    }
+
+    static Index genOf(const Handle h) {
+        return (Index)(h >> 32);
+    }
+
+    Index allocate() {
+        Index i;
+        if (freeNodes != NIL) {
+            i = freeNodes;
+            freeNodes = nodes[i].next;
+        } else {
+            i = (Index)nodes.size();
+            nodes.push_back(Node());
+            nodes[i].gen = epoch;
+        }
+        ++size;
+        return i;
+    }
+
+    void release(const Index i) {
+        nodes[i].slot = NIL;
+        ++nodes[i].gen;
+        nodes[i].next = freeNodes;
+        freeNodes = i;
+        --size;
+    }
+
+    Handle place(const Index i, const Time expire) {
+        nodes[i].expire = (expire > time ? expire : time + 1);
+        insert(i);
+        return ((Handle)nodes[i].gen << 32) | i;
+    }
+
+    /*
+    Insert a node to the slot of its expiration time.
+    */
+    void insert(const Index i) {
+        const Time e = nodes[i].expire;
+        const Time delta = e - (time + 1);
+        Index slot = OVERFLOW_SLOT;
+        for (SizeType k = 0; k < LEVEL_NUM; ++k) {
+            if (delta < ((Time)1 << (LEVEL_BITS * (k + 1)))) {
+                slot = (Index)(k * SLOTS_PER_LEVEL + ((e >> (LEVEL_BITS * k)) & SLOT_MASK));
+                break;
+            }
+        }
+        link(i, slot);
+    }
+
+    void link(const Index i, const Index slot) {
+        Node &n = nodes[i];
+        n.slot = slot;
+        n.prev = NIL;
+        n.next = heads[slot];
+        if (n.next != NIL) {
+            nodes[n.next].prev = i;
+        }
+        heads[slot] = i;
+        if (slot < OVERFLOW_SLOT) {
+            bitmap[slot / 64] |= (std::uint64_t)1 << (slot % 64);
+        }
+    }
+
+    void unlink(const Index i) {
+        Node &n = nodes[i];
+        if (n.prev != NIL) {
+            nodes[n.prev].next = n.next;
+        } else {
+            heads[n.slot] = n.next;
+            if (n.next == NIL) {
+                clearBit(n.slot);
+            }
+        }
+        if (n.next != NIL) {
+            nodes[n.next].prev = n.prev;
+        }
+    }
+
+    /*
+    Move all nodes of a slot to another slot, which is empty.
+    */
+    void moveSlot(const Index from, const Index to) {
+        heads[to] = heads[from];
+        heads[from] = NIL;
+        for (Index i = heads[to]; i != NIL; i = nodes[i].next) {
+            nodes[i].slot = to;
+        }
+        clearBit(from);
+    }
+
+    void clearBit(const Index slot) {
+        if (slot < OVERFLOW_SLOT) {
+            bitmap[slot / 64] &= ~((std::uint64_t)1 << (slot % 64));
+        }
+    }
+
+    /*
+    Move the timers in the slots starting at a tick to lower levels,
+    from the highest level to level 1.
+    */
+    void cascade(const Time tick) {
+        SizeType top = 1;
+        while (top < LEVEL_NUM && (tick & (((Time)1 << (LEVEL_BITS * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        // 'top' is LEVEL_NUM if the overflow list needs to be checked as well
+        for (SizeType k = top + 1; k-- > 1;) {
+            const Index slot = (k == LEVEL_NUM ? OVERFLOW_SLOT :
+                (Index)(k * SLOTS_PER_LEVEL + ((tick >> (LEVEL_BITS * k)) & SLOT_MASK)));
+            Index i = heads[slot];
+            heads[slot] = NIL;
+            clearBit(slot);
+            while (i != NIL) {
+                const Index next = nodes[i].next;
+                insert(i);
+                i = next;
+            }
+        }
+    }
+
+    /*
+    Return the index of the first non-empty slot of a level starting
+    from a given index, or SLOTS_PER_LEVEL if there is none.
+    */
+    SizeType nextSlot(const SizeType level, const SizeType from) const {
+        const std::uint64_t *bits = bitmap + level * BITMAP_WORDS;
+        SizeType w = from / 64;
+        std::uint64_t word = bits[w] & (~(std::uint64_t)0 << (from % 64));
+        while (true) {
+            if (word) {
+                return w * 64 + countTrailingZeros(word);
+            }
+            if (++w == BITMAP_WORDS) {
+                return SLOTS_PER_LEVEL;
+            }
+            word = bits[w];
+        }
+    }
+
+    /*
+    Return the first tick not earlier than a given tick at which a
+    non-empty slot is fired or cascaded. It may also return the start
+    of the next round of a level whose non-empty slots are all in
+    that round, or the next cascade of the overflow list.
+    Precondition: There are pending timers.
+    */
+    Time nextTick(const Time from) const {
+        Time best = ~(Time)0;
+        for (SizeType k = 0; k <= LEVEL_NUM; ++k) {
+            const SizeType shift = LEVEL_BITS * k;
+            const Time unit = (Time)1 << shift;
+            const Time start = (from + unit - 1) & ~(unit - 1);  // The next slot start
+            Time t;
+            if (k == LEVEL_NUM) {
+                if (heads[OVERFLOW_SLOT] == NIL) {
+                    continue;
+                }
+                t = start;
+            } else {
+                const Time roundStart = (start >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS);
+                const SizeType s = nextSlot(k, (SizeType)((start >> shift) & SLOT_MASK));
+                if (s < SLOTS_PER_LEVEL) {
+                    t = roundStart + ((Time)s << shift);
+                } else if (nextSlot(k, 0) < SLOTS_PER_LEVEL) {
+                    t = roundStart + (unit << LEVEL_BITS);
+                } else {
+                    continue;
+                }
+            }
+            best = (t < best ? t : best);
+        }
+        return best;
+    }
+
+    static SizeType countTrailingZeros(const std::uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll((unsigned long long)x);
+#else
+        SizeType n = 0;
+        for (std::uint64_t y = x; !(y & 1); y >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    /*
+    Fire the timers in a slot of level 0. The slot is detached first,
+    so the timers scheduled in the callback go to the next round.
+    */
+    template<typename Callback>
+    SizeType fire(const SizeType s, Callback &cb) {
+        moveSlot((Index)s, FIRING_SLOT);
+        SizeType fired = 0;
+        while (heads[FIRING_SLOT] != NIL) {
+            const Index i = heads[FIRING_SLOT];
+            unlink(i);
+            Value val(std::move(nodes[i].val));
+            release(i);
+            cb(val);
+            ++fired;
+        }
+        return fired;
+    }
+};
+
+template<typename Value>
+const typename TimingWheel<Value>::Index TimingWheel<Value>::NIL;
+
+template<typename Value>
+const typename TimingWheel<Value>::SizeType TimingWheel<Value>::LEVEL_NUM;
+
+template<typename Value>
+const typename TimingWheel<Value>::SizeType TimingWheel<Value>::LEVEL_BITS;
+
+template<typename Value>
+const typename TimingWheel<Value>::SizeType TimingWheel<Value>::SLOTS_PER_LEVEL;
+
+template<typename Value>
+const typename TimingWheel<Value>::Time TimingWheel<Value>::SLOT_MASK;
+
+template<typename Value>
+const typename TimingWheel<Value>::Index TimingWheel<Value>::OVERFLOW_SLOT;
+
+template<typename Value>
+const typename TimingWheel<Value>::Index TimingWheel<Value>::FIRING_SLOT;
+
+template<typename Value>
+const typename TimingWheel<Value>::SizeType TimingWheel<Value>::SLOT_NUM;
+
+template<typename Value>
+const typename TimingWheel<Value>::SizeType TimingWheel<Value>::BITMAP_WORDS;
+
+TASTYLIB_NS_END
+
+#endif
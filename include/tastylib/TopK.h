@@ -0,0 +1,214 @@
+#ifndef TASTYLIB_TOPK_H_
+#define TASTYLIB_TOPK_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/BinaryHeap.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A fixed-capacity container keeping the best K values of a stream.
+
+The kept values are stored in a BinaryHeap whose root is the worst of
+them, which is the threshold a new value must beat. Once the container
+is full, a value that does not beat the threshold is rejected with a
+single comparison, and a value that does replaces the root with one
+percolation down instead of a push() followed by a pop().
+
+@param Value The type of the values
+@param Pred  The type of the binary predicate of the underlying heap.
+             A value V beats the threshold T if Pred(T, V) == false.
+             By default it uses operator '>=', which keeps the K
+             largest values.
+@param Arity The arity of the underlying heap
+*/
+template<typename Value, typename Pred = std::greater_equal<Value>,
+         std::size_t Arity = 2>
+class TopK {
+public:
+    typedef BinaryHeap<Value, Pred, Arity> Heap;
+    typedef typename Heap::SizeType SizeType;
+
+    /*
+    Destructor.
+    */
+    ~TopK() {}
+
+    /*
+    Initialize the container.
+
+    @param capacity_ The amount of values to be kept
+    */
+    explicit TopK(const SizeType capacity_) : capacity(capacity_) {}
+
+    /*
+    Return the amount of values to be kept.
+    */
+    SizeType getCapacity() const {
+        return capacity;
+    }
+
+    /*
+    Return the amount of values kept.
+    */
+    SizeType getSize() const {
+        return heap.getSize();
+    }
+
+    /*
+    Return true if no value is kept.
+    */
+    bool isEmpty() const {
+        return heap.isEmpty();
+    }
+
+    /*
+    Return true if the amount of values kept reaches the capacity.
+    */
+    bool isFull() const {
+        return heap.getSize() >= capacity;
+    }
+
+    /*
+    Remove all kept values.
+    */
+    void clear() {
+        heap.clear();
+    }
+
+    /*
+    Return the worst of the kept values. When the container is
+    full, a new value is kept only if it beats this one.
+    Precondition: The container is non-empty.
+    */
+    const Value& getThreshold() const {
+        return heap.top();
+    }
+
+    /*
+    Offer a value to the container.
+
+    @param val The value
+    @return    True if the value is kept.
+    */
+    bool offer(const Value &val) {
+        if (!isFull()) {
+            heap.push(val);
+            return true;
+        }
+        if (capacity == 0 || pred(heap.top(), val)) {
+            return false;
+        }
+        heap.replaceTop(val);
+        return true;
+    }
+
+    /*
+    Offer a value to the container. The value is moved into the
+    container if it is kept.
+
+    @param val The value
+    @return    True if the value is kept.
+    */
+    bool offer(Value &&val) {
+        if (!isFull()) {
+            heap.push(std::move(val));
+            return true;
+        }
+        if (capacity == 0 || pred(heap.top(), val)) {
+            return false;
+        }
+        heap.replaceTop(std::move(val));
+        return true;
+    }
+
+    /*
+    Offer the values in a range. For random access iterators, the values
+    are checked against the threshold block by block in a branch-free loop
+    that the compiler can vectorize, and a block is skipped as a whole if
+    none of its values beats the threshold.
+
+    @param first The iterator to the first value
+    @param last  The iterator past the last value
+    @return      The amount of values kept.
+    */
+    template<typename InputIt>
+    SizeType offer(InputIt first, InputIt last) {
+        return offerRange(first, last,
+                          typename std::iterator_traits<InputIt>::iterator_category());
+    }
+
+    /*
+    Move the kept values out of the container in order from the best
+    to the worst. The container becomes empty afterwards.
+    */
+    std::vector<Value> extractSorted() {
+        std::vector<Value> res;
+        res.reserve(heap.getSize());
+        while (!heap.isEmpty()) {
+            res.push_back(heap.popTop());
+        }
+        std::reverse(res.begin(), res.end());
+        return res;
+    }
+
+private:
+    /*
+    The amount of values checked against the threshold at a time.
+    */
+    static const SizeType BLOCK_SIZE = 256;
+
+    SizeType capacity;
+    Pred pred;
+    Heap heap;
+
+    template<typename InputIt>
+    SizeType offerRange(InputIt first, InputIt last, std::input_iterator_tag) {
+        SizeType cnt = 0;
+        for (; first != last; ++first) {
+            cnt += offer(*first);
+        }
+        return cnt;
+    }
+
+    template<typename RandomIt>
+    SizeType offerRange(RandomIt first, RandomIt last, std::random_access_iterator_tag) {
+        if (capacity == 0) {
+            return 0;
+        }
+        SizeType cnt = 0;
+        if (!isFull()) {
+            SizeType n = std::min((SizeType)(last - first), capacity - heap.getSize());
+            heap.pushRange(first, first + n);
+            first += n;
+            cnt += n;
+        }
+        while (first != last) {
+            SizeType n = std::min((SizeType)(last - first), BLOCK_SIZE);
+            const Value &threshold = heap.top();
+            SizeType beat = 0;
+            for (SizeType i = 0; i < n; ++i) {
+                beat += !pred(threshold, first[i]);
+            }
+            if (beat > 0) {
+                for (SizeType i = 0; i < n; ++i) {
+                    cnt += offer(first[i]);
+                }
+            }
+            first += n;
+        }
+        return cnt;
+    }
+};
+
+template<typename Value, typename Pred, std::size_t Arity>
+const typename TopK<Value, Pred, Arity>::SizeType TopK<Value, Pred, Arity>::BLOCK_SIZE;
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef TASTYLIB_UNROLLEDLINKEDLIST_H_
+#define TASTYLIB_UNROLLEDLINKEDLIST_H_
+
+#include "tastylib/internal/base.h"
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <new>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A doubly linked list in which each node(chunk) stores a small array
+of values. Traversing the list follows one pointer per chunk instead
+of one pointer per value. A full chunk is split into two halves when
+a value is inserted into its middle, and a chunk is merged with its
+neighbor when a removal leaves them small enough to fit in one chunk.
+
+@param Value      The type of list node value.
+@param Pred       A binary predicate that checks if two node values
+                  are equal. If Pred(a, b) == true, then value 'a'
+                  and value 'b' are considered equal.
+@param ChunkBytes The size of the values array of a chunk in bytes.
+                  The default value fits two cache lines.
+*/
+template<typename Value, typename Pred = std::equal_to<Value>,
+         std::size_t ChunkBytes = 128>
+class UnrolledLinkedList {
+public:
+    typedef std::size_t SizeType;
+
+    /*
+    The maximum amount of values in a chunk.
+    */
+    static const SizeType CHUNK_CAPACITY =
+        (ChunkBytes / sizeof(Value) > 4 ? ChunkBytes / sizeof(Value) : 4);
+
+    struct Chunk {
+        Chunk *prev;
+        Chunk *next;
+        SizeType count;
+        typename std::aligned_storage<sizeof(Value), alignof(Value)>::type
+            data[CHUNK_CAPACITY];
+
+        Chunk(Chunk *p = nullptr, Chunk *n = nullptr)
+            : prev(p), next(n), count(0) {}
+
+        Value* vals() {
+            return reinterpret_cast<Value*>(data);
+        }
+
+        const Value* vals() const {
+            return reinterpret_cast<const Value*>(data);
+        }
+    };
+
+    /*
+    Destructor.
+    */
+    ~UnrolledLinkedList() {
+        clear();
+    }
+
+    /*
+    Default constructor.
+    */
+    UnrolledLinkedList() : size(0), head(nullptr), tail(nullptr) {}
+
+    UnrolledLinkedList(const UnrolledLinkedList &) = delete;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList &) = delete;
+
+    /*
+    Return the amount of values in the list.
+    */
+    SizeType getSize() const {
+        return size;
+    }
+
+    /*
+    Return true if the list is empty.
+    */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /*
+    Clear the content of the list.
+    */
+    void clear() {
+        Chunk *tmp = head, *del;
+        while (tmp) {
+            del = tmp;
+            tmp = tmp->next;
+            destroy(del->vals(), del->vals() + del->count);
+            delete del;
+        }
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    /*
+    Traverse the list values.
+
+    @param f The function to traverse each value. Params are:
+             @param pos The position of the current traversing value
+             @param val The current traversing value
+    */
+    void traverse(const std::function<void(const SizeType pos,
+                                           const Value &val)> &f) const {
+        SizeType pos = 0;
+        for (const Chunk *c = head; c; c = c->next) {
+            const Value *v = c->vals();
+            for (SizeType i = 0; i < c->count; ++i, ++pos) {
+                f(pos, v[i]);
+            }
+        }
+    }
+
+    /*
+    Find a value in the list.
+
+    @param val_ The value to be found
+    @return     The first matching position of the value 'val_'.
+                If the value does not exist, return -1.
+    */
+    int find(const Value &val_) const {
+        Pred pred;
+        SizeType pos = 0;
+        for (const Chunk *c = head; c; c = c->next) {
+            const Value *v = c->vals();
+            for (SizeType i = 0; i < c->count; ++i) {
+                if (pred(v[i], val_)) {
+                    return (int)(pos + i);
+                }
+            }
+            pos += c->count;
+        }
+        return -1;
+    }
+
+    /*
+    Insert a value at a given position. If the position is greater than
+    the list's size, the value will be inserted to the back of the list.
+
+    @param pos The position to insert the value
+    @param val The value to be inserted
+    */
+    void insert(SizeType pos, const Value &val) {
+        pos = (pos > size ? size : pos);
+        if (pos == 0) {
+            insertFront(val);
+        } else if (pos == size) {
+            insertBack(val);
+        } else {
+            SizeType off = pos;
+            Chunk *c = locate(off);
+            if (c->count == CHUNK_CAPACITY) {
+                split(c);
+                if (off > c->count) {
+                    off -= c->count;
+                    c = c->next;
+                }
+            }
+            insertAt(c, off, val);
+        }
+    }
+
+    /*
+    Insert a value at the front of the list.
+
+    @param val The value to be inserted
+    */
+    void insertFront(const Value &val) {
+        if (!head || head->count == CHUNK_CAPACITY) {
+            linkChunk(nullptr, head);
+        }
+        insertAt(head, 0, val);
+    }
+
+    /*
+    Insert a value at the back of the list.
+
+    @param val The value to be inserted
+    */
+    void insertBack(const Value &val) {
+        if (!tail || tail->count == CHUNK_CAPACITY) {
+            linkChunk(tail, nullptr);
+        }
+        insertAt(tail, tail->count, val);
+    }
+
+    /*
+    Remove a value at a given position. If there is no value
+    at the given position, this function does nothing.
+
+    @param pos The position of the value to be removed
+    */
+    void remove(SizeType pos) {
+        if (pos < size) {
+            Chunk *c = locate(pos);
+            removeAt(c, pos);
+        }
+    }
+
+    /*
+    Remove the first value of the list.
+    */
+    void removeFront() {
+        if (!isEmpty()) {
+            removeAt(head, 0);
+        }
+    }
+
+    /*
+    Remove the last value of the list.
+    */
+    void removeBack() {
+        if (!isEmpty()) {
+            removeAt(tail, tail->count - 1);
+        }
+    }
+
+    /*
+    Sort the list values in ascending order.
+    */
+    void sort() {
+        sort(std::less<Value>());
+    }
+
+    /*
+    Sort the list values in custom order. The sort is stable.
+
+    @param cmp A binary predicate to compare two values. The sorting
+               algorithm ensures that after its execution, for each value A
+               and its next value B in the list, A == B OR cmp(A, B) == true.
+    */
+    template<typename Comparator>
+    void sort(const Comparator &cmp) {
+        std::vector<Value> vals;
+        vals.reserve(size);
+        for (Chunk *c = head; c; c = c->next) {
+            std::move(c->vals(), c->vals() + c->count, std::back_inserter(vals));
+        }
+        std::stable_sort(vals.begin(), vals.end(), cmp);
+        auto it = vals.begin();
+        for (Chunk *c = head; c; c = c->next) {
+            std::move(it, it + c->count, c->vals());
+            it += c->count;
+        }
+    }
+
+private:
+    SizeType size;
+    Chunk *head;
+    Chunk *tail;
+
+    /*
+    Destroy the values in the range [first, last).
+    */
+    static void destroy(Value *first, Value *last) {
+        for (; first != last; ++first) {
+            first->~Value();
+        }
+    }
+
+    /*
+    Return the chunk that stores the value at a given position,
+    walking from the nearer end of the list.
+
+    @param pos The given position. Its value must lie in the interval
+               [0, size). After its execution, it is the offset of
+               the value in the returned chunk.
+    */
+    Chunk* locate(SizeType &pos) const {
+        Chunk *c;
+        if (pos < size - pos) {
+            c = head;
+            while (pos >= c->count) {
+                pos -= c->count;
+                c = c->next;
+            }
+        } else {
+            SizeType rest = size - pos;  // Amount of values from 'pos' to the end
+            c = tail;
+            while (rest > c->count) {
+                rest -= c->count;
+                c = c->prev;
+            }
+            pos = c->count - rest;
+        }
+        return c;
+    }
+
+    /*
+    Create an empty chunk and link it between two adjacent chunks.
+
+    @param p The chunk before the new chunk
+    @param n The chunk after the new chunk
+    */
+    void linkChunk(Chunk *p, Chunk *n) {
+        Chunk *c = new Chunk(p, n);
+        if (p) {
+            p->next = c;
+        } else {
+            head = c;
+        }
+        if (n) {
+            n->prev = c;
+        } else {
+            tail = c;
+        }
+    }
+
+    /*
+    Unlink a chunk from the list and free it.
+    Precondition: The chunk has no values.
+    */
+    void unlinkChunk(Chunk *c) {
+        if (c->prev) {
+            c->prev->next = c->next;
+        } else {
+            head = c->next;
+        }
+        if (c->next) {
+            c->next->prev = c->prev;
+        } else {
+            tail = c->prev;
+        }
+        delete c;
+    }
+
+    /*
+    Move the upper half of a full chunk to a new chunk after it.
+    */
+    void split(Chunk *c) {
+        linkChunk(c, c->next);
+        Chunk *n = c->next;
+        SizeType half = c->count / 2;
+        Value *src = c->vals() + half, *dst = n->vals();
+        for (SizeType i = half; i < c->count; ++i, ++src, ++dst) {
+            new (dst) Value(std::move(*src));
+            src->~Value();
+        }
+        n->count = c->count - half;
+        c->count = half;
+    }
+
+    /*
+    Insert a value into a chunk.
+    Precondition: The chunk is not full.
+
+    @param c   The chunk
+    @param off The offset in the chunk to insert the value
+    @param val The value to be inserted
+    */
+    void insertAt(Chunk *c, const SizeType off, const Value &val) {
+        Value *v = c->vals();
+        if (off == c->count) {
+            new (v + off) Value(val);
+        } else {
+            Value tmp(val);  // 'val' may refer to a value in this chunk
+            new (v + c->count) Value(std::move(v[c->count - 1]));
+            std::move_backward(v + off, v + c->count - 1, v + c->count);
+            v[off] = std::move(tmp);
+        }
+        ++c->count;
+        ++size;
+    }
+
+    /*
+    Remove a value from a chunk. The chunk is freed if it becomes
+    empty, or merged with a neighbor if both of them fit in one chunk.
+
+    @param c   The chunk
+    @param off The offset of the value in the chunk
+    */
+    void removeAt(Chunk *c, const SizeType off) {
+        Value *v = c->vals();
+        std::move(v + off + 1, v + c->count, v + off);
+        v[--c->count].~Value();
+        --size;
+        if (c->count == 0) {
+            unlinkChunk(c);
+        } else if (c->count < CHUNK_CAPACITY / 2) {
+            if (c->next && c->count + c->next->count <= CHUNK_CAPACITY) {
+                mergeNext(c);
+            } else if (c->prev && c->prev->count + c->count <= CHUNK_CAPACITY) {
+                mergeNext(c->prev);
+            }
+        }
+    }
+
+    /*
+    Move all values of the next chunk into a chunk and free the next chunk.
+    Precondition: The values of both chunks fit in one chunk.
+    */
+    void mergeNext(Chunk *c) {
+        Chunk *n = c->next;
+        Value *src = n->vals(), *dst = c->vals() + c->count;
+        for (SizeType i = 0; i < n->count; ++i, ++src, ++dst) {
+            new (dst) Value(std::move(*src));
+            src->~Value();
+        }
+        c->count += n->count;
+        n->count = 0;
+        unlinkChunk(n);
+    }
+};
+
+template<typename Value, typename Pred, std::size_t ChunkBytes>
+const typename UnrolledLinkedList<Value, Pred, ChunkBytes>::SizeType
+UnrolledLinkedList<Value, Pred, ChunkBytes>::CHUNK_CAPACITY;
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef TASTYLIB_FLATTABLE_H_
+#define TASTYLIB_FLATTABLE_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/util/aligned_allocator.h"
+#include "tastylib/Hash.h"
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TASTYLIB_FLATTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+TASTYLIB_NS_BEGIN
+
+namespace internal {
+
+/*
+A functor that returns a slot itself as its key.
+*/
+struct SlotIdentity {
+    template<typename T>
+    const T& operator()(const T &slot) const {
+        return slot;
+    }
+};
+
+/*
+The open-addressing core shared by FlatHashTable and HashMap.
+
+Each slot has a one-byte control tag, which is either EMPTY, DELETED
+(a tombstone), or the low 7 bits of the hash value of its element. The
+slots are probed in groups of 16, and all tags of a group are compared
+with the 7 hash bits at once by SSE2 instructions, or by a portable loop
+if SSE2 is not available. The table grows when the slots in use,
+including tombstones, exceed 7/8 of the capacity.
+
+Lookups take any key type K for which hasher(k) and pred(key, k) are
+defined, where 'key' is the key of a stored slot. They must agree with
+hasher and pred on the key type itself.
+
+@param Slot  The type of the elements stored in the slots
+@param KeyOf A functor that returns the key of a slot
+@param Pred  A binary predicate that checks if two keys are equal
+@param Hash  A unary functor that computes the hash value of a key.
+             Its result is mixed before use.
+*/
+template<typename Slot, typename KeyOf, typename Pred, typename Hash>
+class FlatTable {
+public:
+    typedef std::size_t SizeType;
+
+    static const SizeType NPOS = (SizeType)-1;
+
+    ~FlatTable() {
+        destroyAll();
+        ::operator delete(slots);
+    }
+
+    explicit FlatTable(const SizeType n = 0)
+        : size(0), tombstones(0), capacity(0), slots(nullptr) {
+        resize(capacityFor(n));
+    }
+
+    FlatTable(const FlatTable &) = delete;
+    FlatTable& operator=(const FlatTable &) = delete;
+
+    SizeType getSize() const {
+        return size;
+    }
+
+    SizeType getCapacity() const {
+        return capacity;
+    }
+
+    Slot& slot(const SizeType i) const {
+        return slots[i];
+    }
+
+    /*
+    Return true if slot i holds an element.
+    */
+    bool isFull(const SizeType i) const {
+        return ctrl[i] >= 0;
+    }
+
+    void clear() {
+        destroyAll();
+        ctrl.assign(capacity, EMPTY);
+        size = 0;
+        tombstones = 0;
+    }
+
+    /*
+    Compute the hash value of a key, whose bits are mixed by mixInt()
+    so that all of them depend on all input bits. The low 7 bits are
+    the tag and the rest select the group.
+    */
+    template<typename K>
+    SizeType hash(const K &key) const {
+        return (SizeType)mixInt(hasher(key));
+    }
+
+    /*
+    Return the index of the slot whose key equals a key, or NPOS.
+    The groups are probed in triangular steps, which visit all
+    groups since the amount of groups is a power of 2.
+
+    @param key The key
+    @param h   The hash value of the key returned by hash()
+    */
+    template<typename K>
+    SizeType findIndex(const K &key, const SizeType h) const {
+        const std::int8_t tag = tagOf(h);
+        SizeType g = firstGroup(h);
+        for (SizeType step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            Group group(&ctrl[g]);
+            for (std::uint32_t mask = group.match(tag); mask; mask &= mask - 1) {
+                const SizeType i = g + countTrailingZeros(mask);
+                if (pred(keyOf(slots[i]), key)) {
+                    return i;
+                }
+            }
+            if (group.matchEmpty()) {
+                return NPOS;
+            }
+            g = (g + step) & (capacity - 1);
+        }
+    }
+
+    template<typename K>
+    SizeType findIndex(const K &key) const {
+        return findIndex(key, hash(key));
+    }
+
+    /*
+    Make room for a new element of a hash value, and return the index of
+    a free slot for it. The table grows if it is too full, or is rehashed
+    in place if most used slots are tombstones. The caller constructs the
+    element in the slot and then calls commit().
+    */
+    SizeType prepareInsert(const SizeType h) {
+        if (size + tombstones + 1 > maxLoad(capacity)) {
+            resize(size + 1 > maxLoad(capacity) / 2 ? capacity * 2 : capacity);
+        }
+        return findFree(h);
+    }
+
+    /*
+    Mark slot i returned by prepareInsert() as holding the element
+    constructed in it.
+    */
+    void commit(const SizeType i, const SizeType h) {
+        if (ctrl[i] == DELETED) {
+            --tombstones;
+        }
+        ctrl[i] = tagOf(h);
+        ++size;
+    }
+
+    /*
+    Destroy the element in slot i.
+    */
+    void erase(const SizeType i) {
+        slots[i].~Slot();
+        --size;
+        // A group that has an empty slot has never been full, so no
+        // probe has passed it, and the slot can become empty again.
+        if (Group(&ctrl[i & ~(GROUP_WIDTH - 1)]).matchEmpty()) {
+            ctrl[i] = EMPTY;
+        } else {
+            ctrl[i] = DELETED;
+            ++tombstones;
+        }
+    }
+
+    /*
+    Move all elements to new arrays that fit at least n elements.
+    The tombstones are removed.
+    */
+    void rehash(const SizeType n) {
+        resize(capacityFor(n > size ? n : size));
+    }
+
+private:
+    static const SizeType GROUP_WIDTH = 16;
+    static const std::int8_t EMPTY = -128;   // 0b10000000
+    static const std::int8_t DELETED = -2;   // 0b11111110
+
+    /*
+    A group of control tags. A match returns a bit mask whose bit i
+    is set if tag i matches.
+    */
+    struct Group {
+#ifdef TASTYLIB_FLATTABLE_SSE2
+        __m128i tags;
+
+        explicit Group(const std::int8_t *p)
+            : tags(_mm_load_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        std::uint32_t match(const std::int8_t h2) const {
+            return (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(h2)));
+        }
+
+        std::uint32_t matchEmpty() const {
+            return match(EMPTY);
+        }
+
+        std::uint32_t matchEmptyOrDeleted() const {
+            return (std::uint32_t)_mm_movemask_epi8(tags);  // The sign bits
+        }
+#else
+        const std::int8_t *tags;
+
+        explicit Group(const std::int8_t *p) : tags(p) {}
+
+        std::uint32_t match(const std::int8_t h2) const {
+            std::uint32_t mask = 0;
+            for (SizeType i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= (std::uint32_t)(tags[i] == h2) << i;
+            }
+            return mask;
+        }
+
+        std::uint32_t matchEmpty() const {
+            return match(EMPTY);
+        }
+
+        std::uint32_t matchEmptyOrDeleted() const {
+            std::uint32_t mask = 0;
+            for (SizeType i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= (std::uint32_t)(tags[i] < 0) << i;
+            }
+            return mask;
+        }
+#endif
+    };
+
+    KeyOf keyOf;
+    Pred pred;
+    Hash hasher;
+
+    SizeType size;
+    SizeType tombstones;
+    SizeType capacity;  // A power of 2 and a multiple of GROUP_WIDTH
+    std::vector<std::int8_t, AlignedAllocator<std::int8_t, GROUP_WIDTH>> ctrl;
+    Slot *slots;
+
+    static SizeType countTrailingZeros(const std::uint32_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctz(x);
+#else
+        SizeType n = 0;
+        for (std::uint32_t y = x; !(y & 1); y >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    /*
+    Return the maximum amount of used slots of a capacity.
+    */
+    static SizeType maxLoad(const SizeType cap) {
+        return cap - cap / 8;
+    }
+
+    static SizeType capacityFor(const SizeType n) {
+        SizeType cap = GROUP_WIDTH;
+        while (maxLoad(cap) < n) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    static std::int8_t tagOf(const SizeType h) {
+        return (std::int8_t)(h & 0x7F);
+    }
+
+    SizeType firstGroup(const SizeType h) const {
+        return ((h >> 7) * GROUP_WIDTH) & (capacity - 1);
+    }
+
+    /*
+    Return the index of the first empty or deleted slot on the
+    probe sequence of a hash value.
+    */
+    SizeType findFree(const SizeType h) const {
+        SizeType g = firstGroup(h);
+        for (SizeType step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            std::uint32_t mask = Group(&ctrl[g]).matchEmptyOrDeleted();
+            if (mask) {
+                return g + countTrailingZeros(mask);
+            }
+            g = (g + step) & (capacity - 1);
+        }
+    }
+
+    /*
+    Move all elements to new arrays of a given capacity.
+    */
+    void resize(const SizeType newCap) {
+        std::vector<std::int8_t, AlignedAllocator<std::int8_t, GROUP_WIDTH>> oldCtrl(newCap, EMPTY);
+        oldCtrl.swap(ctrl);
+        Slot *oldSlots = slots;
+        const SizeType oldCap = capacity;
+        slots = static_cast<Slot*>(::operator new(newCap * sizeof(Slot)));
+        capacity = newCap;
+        tombstones = 0;
+        for (SizeType i = 0; i < oldCap; ++i) {
+            if (oldCtrl[i] >= 0) {
+                const SizeType h = hash(keyOf(oldSlots[i]));
+                const SizeType j = findFree(h);
+                ctrl[j] = tagOf(h);
+                new (slots + j) Slot(std::move(oldSlots[i]));
+                oldSlots[i].~Slot();
+            }
+        }
+        ::operator delete(oldSlots);
+    }
+
+    void destroyAll() {
+        for (SizeType i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                slots[i].~Slot();
+            }
+        }
+    }
+};
+
+template<typename Slot, typename KeyOf, typename Pred, typename Hash>
+const typename FlatTable<Slot, KeyOf, Pred, Hash>::SizeType FlatTable<Slot, KeyOf, Pred, Hash>::NPOS;
+
+template<typename Slot, typename KeyOf, typename Pred, typename Hash>
+const typename FlatTable<Slot, KeyOf, Pred, Hash>::SizeType FlatTable<Slot, KeyOf, Pred, Hash>::GROUP_WIDTH;
+
+template<typename Slot, typename KeyOf, typename Pred, typename Hash>
+const std::int8_t FlatTable<Slot, KeyOf, Pred, Hash>::EMPTY;
+
+template<typename Slot, typename KeyOf, typename Pred, typename Hash>
+const std::int8_t FlatTable<Slot, KeyOf, Pred, Hash>::DELETED;
+
+}
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef TASTYLIB_ALIGNEDALLOCATOR_H_
+#define TASTYLIB_ALIGNEDALLOCATOR_H_
+
+#include "tastylib/internal/base.h"
+#include <new>
+#include <cstdint>
+#include <cstring>
+
+TASTYLIB_NS_BEGIN
+
+/*
+An allocator whose memory blocks start at a multiple of a given
+alignment, e.g. the start of a cache line. It can be used by
+standard containers such as std::vector.
+
+@param T         The type of the allocated elements.
+@param Alignment The alignment of the memory blocks in bytes.
+                 It must be a power of 2.
+@param Offset    The distance in bytes from the start of a memory block
+                 to the aligned address, which lets the element at a
+                 given index, instead of the first one, start at the
+                 aligned address. It must be a multiple of alignof(T).
+*/
+template<typename T, std::size_t Alignment = 64, std::size_t Offset = 0>
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment, Offset> other;
+    };
+
+    AlignedAllocator() {}
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment, Offset> &) {}
+
+    /*
+    Allocate a memory block that starts 'Offset' bytes before an aligned
+    address. The address returned by ::operator new is stored right
+    before the block.
+
+    @param n The amount of elements
+    */
+    T* allocate(const std::size_t n) {
+        void *raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + Offset;
+        addr = ((addr + Alignment - 1) & ~(Alignment - 1)) - Offset;
+        std::memcpy(reinterpret_cast<char*>(addr) - sizeof(void*), &raw, sizeof(void*));
+        return reinterpret_cast<T*>(addr);
+    }
+
+    /*
+    Release a memory block returned by allocate().
+    */
+    void deallocate(T *p, const std::size_t) {
+        void *raw;
+        std::memcpy(&raw, reinterpret_cast<char*>(p) - sizeof(void*), sizeof(void*));
+        ::operator delete(raw);
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment, Offset> &) const {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment, Offset> &) const {
+        return false;
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef TASTYLIB_STRINGREF_H_
+#define TASTYLIB_STRINGREF_H_
+
+#include "tastylib/internal/base.h"
+#include "tastylib/Hash.h"
+#include <cstring>
+#include <string>
+
+TASTYLIB_NS_BEGIN
+
+/*
+A non-owning reference to a sequence of characters, like the
+std::string_view of C++17. It is cheap to copy and never allocates,
+so it can be used to look up std::string keys in a HashMap without
+constructing a std::string.
+*/
+class StringRef {
+public:
+    typedef std::size_t SizeType;
+
+    StringRef() : ptr(""), len(0) {}
+
+    StringRef(const char *str) : ptr(str), len(std::strlen(str)) {}
+
+    StringRef(const char *str, const SizeType n) : ptr(str), len(n) {}
+
+    StringRef(const std::string &str) : ptr(str.data()), len(str.size()) {}
+
+    /*
+    Return the pointer to the first character.
+    The characters may not end with '\0'.
+    */
+    const char* getData() const {
+        return ptr;
+    }
+
+    /*
+    Return the amount of characters.
+    */
+    SizeType getSize() const {
+        return len;
+    }
+
+    /*
+    Return true if there is no character.
+    */
+    bool isEmpty() const {
+        return len == 0;
+    }
+
+    /*
+    Copy the characters to a std::string.
+    */
+    explicit operator std::string() const {
+        return std::string(ptr, len);
+    }
+
+    bool operator==(const StringRef &other) const {
+        return len == other.len && std::memcmp(ptr, other.ptr, len) == 0;
+    }
+
+    bool operator!=(const StringRef &other) const {
+        return !(*this == other);
+    }
+
+private:
+    const char *ptr;
+    SizeType len;
+};
+
+/*
+A hash functor that gives std::string, StringRef and C strings with
+the same characters the same hash value, so that a hash container of
+std::string keys can be looked up by any of them. The hash values are
+those of hashBytes(), and so equal those of Hasher<std::string>.
+*/
+struct StringHash {
+    std::size_t operator()(const StringRef &str) const {
+        return (std::size_t)hashBytes(str.getData(), str.getSize());
+    }
+};
+
+/*
+An equality predicate between any two of std::string,
+StringRef and C strings.
+*/
+struct StringEqual {
+    bool operator()(const StringRef &a, const StringRef &b) const {
+        return a == b;
+    }
+};
+
+TASTYLIB_NS_END
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "tastylib/internal/base.h"
 #include <ctime>
+#include <chrono>
 #include <functional>
 
 TASTYLIB_NS_BEGIN
@@ -29,6 +30,21 @@ inline double timing(const std::function<void()> &f) {
     return elapse(start);
 }
 
+/*
+Run a function and compute its wall-clock execution time. Unlike
+timing(), the result does not add up the processor time of all
+threads, so it suits functions that run on multiple threads.
+
+@param f The function to be run
+@return  The wall-clock execution time(in millisecond) of the function.
+*/
+inline double wallTiming(const std::function<void()> &f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - start;
+    return d.count();
+}
+
 TASTYLIB_NS_END
 
 #endif
\ No newline at end of file
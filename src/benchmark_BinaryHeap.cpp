@@ -5,12 +5,39 @@
 #include "tastylib/BinaryHeap.h"
 #include <string>
 #include <queue>
+#include <algorithm>
 
 using namespace tastylib;
 using std::string;
 using std::priority_queue;
 using std::vector;
 
+/*
+Push and pop all values with a max-root heap of a given arity, and
+print the average time cost of each operation.
+
+@param vals The values to push
+*/
+template<std::size_t Arity>
+void benchmarkArity(const vector<int> &vals) {
+    const int size = (int)vals.size();
+    BinaryHeap<int, std::less_equal<int>, Arity> heap;
+    auto pushTime = timing([&]() {
+        for (int i = 0; i < size; ++i) {
+            heap.push(vals[i]);
+        }
+    });
+    long long sum = 0;
+    auto popTime = timing([&]() {
+        for (int i = 0; i < size; ++i) {
+            sum += heap.top();
+            heap.pop();
+        }
+    });
+    printLn("Arity " + toString(Arity) + ": push() " + toString(pushTime / size) + " ms, pop() "
+            + toString(popTime / size) + " ms (checksum " + toString(sum) + ")");
+}
+
 int main() {
     printLn("Benchmark of BinaryHeap running...\n");
     {
@@ -66,6 +93,101 @@ int main() {
             printLn("Benchmark of pop() finished.\n");
         }
     }
+    {   // Compare the arities of the heap
+        const int SIZE = 40000000;
+        vector<int> vals;
+        printLn("Benchmarking the arities of BinaryHeap...");
+        printLn("Generating " + toString(SIZE) + " elements to push...");
+        for (int i = 0; i < SIZE; ++i) {
+            vals.push_back(randInt(0, SIZE));
+        }
+        printLn("Finished.");
+        {
+            priority_queue<int> stdHeap;
+            auto pushTime = timing([&]() {
+                for (int i = 0; i < SIZE; ++i) {
+                    stdHeap.push(vals[i]);
+                }
+            });
+            long long sum = 0;
+            auto popTime = timing([&]() {
+                for (int i = 0; i < SIZE; ++i) {
+                    sum += stdHeap.top();
+                    stdHeap.pop();
+                }
+            });
+            printLn("std::priority_queue: push() " + toString(pushTime / SIZE) + " ms, pop() "
+                    + toString(popTime / SIZE) + " ms (checksum " + toString(sum) + ")");
+        }
+        benchmarkArity<2>(vals);
+        benchmarkArity<4>(vals);
+        benchmarkArity<8>(vals);
+        printLn("Benchmark of the arities finished.\n");
+    }
+    {   // Compare building a heap by pushes with building it in O(n) time
+        const int SIZE = 40000000;
+        vector<int> vals;
+        printLn("Benchmarking the construction of BinaryHeap...");
+        printLn("Generating " + toString(SIZE) + " elements...");
+        for (int i = 0; i < SIZE; ++i) {
+            vals.push_back(randInt(0, SIZE));
+        }
+        printLn("Finished.");
+        auto stdTime = timing([&]() {
+            vector<int> arr(vals);
+            std::make_heap(arr.begin(), arr.end());
+        });
+        auto pushTime = timing([&]() {
+            BinaryHeap<int> heap;
+            for (int i = 0; i < SIZE; ++i) {
+                heap.push(vals[i]);
+            }
+        });
+        auto rangeTime = timing([&]() {
+            BinaryHeap<int> heap(vals.begin(), vals.end());
+        });
+        printLn("Total time of std::make_heap() VS push() VS range constructor: "
+                + toString(stdTime) + " ms / " + toString(pushTime) + " ms / "
+                + toString(rangeTime) + " ms");
+        printLn("Benchmark of the construction finished.\n");
+    }
+    {   // Compare copying and moving strings out of the heap
+        const int SIZE = 2000000;
+        vector<string> vals;
+        printLn("Benchmarking a heap of strings...");
+        printLn("Generating " + toString(SIZE) + " strings of 64 characters...");
+        for (int i = 0; i < SIZE; ++i) {
+            vals.push_back(toString(randInt(10000000, 99999999)) + string(56, 'x'));
+        }
+        printLn("Finished.");
+        long long copyLen = 0, moveLen = 0;
+        auto copyTime = timing([&]() {
+            BinaryHeap<string> heap;
+            for (const auto &str : vals) {
+                heap.push(str);
+            }
+            while (!heap.isEmpty()) {
+                string str = heap.top();
+                copyLen += str.size();
+                heap.pop();
+            }
+        });
+        vector<string> moved(vals);
+        auto moveTime = timing([&]() {
+            BinaryHeap<string> heap;
+            for (auto &str : moved) {
+                heap.push(std::move(str));
+            }
+            while (!heap.isEmpty()) {
+                string str = heap.popTop();
+                moveLen += str.size();
+            }
+        });
+        printLn("Total time of copying VS moving push() + pop(): "
+                + toString(copyTime) + " ms / " + toString(moveTime) + " ms (checksum "
+                + toString(copyLen) + " / " + toString(moveLen) + ")");
+        printLn("Benchmark of the heap of strings finished.\n");
+    }
     printLn("Benchmark of BinaryHeap finished.");
     checkMemoryLeaks();
     return 0;
@@ -0,0 +1,155 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/HashTable.h"
+#include "tastylib/ConcurrentHashTable.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace tastylib;
+using std::vector;
+
+/*
+A hash table made of a HashTable guarded by a mutex.
+*/
+class LockedTable {
+public:
+    bool insert(const long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (table.has(val)) {
+            return false;
+        }
+        table.insert(val);
+        return true;
+    }
+
+    bool remove(const long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!table.has(val)) {
+            return false;
+        }
+        table.remove(val);
+        return true;
+    }
+
+    bool has(const long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return table.has(val);
+    }
+
+private:
+    std::mutex mtx;
+    HashTable<long long> table;
+};
+
+/*
+A xorshift generator owned by one thread.
+*/
+struct XorShift {
+    std::uint64_t state;
+
+    explicit XorShift(const std::uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+    std::uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/*
+Run a mixed workload: each operation looks up a random key with a given
+probability, and otherwise inserts or removes a random key, so the table
+stays about half full.
+
+@param table     The table, which is filled with half of the keys
+@param threads   The amount of threads
+@param ops       The amount of operations of each thread
+@param keys      The amount of distinct keys
+@param readRatio The percentage of lookups
+@return          The amount of successful operations.
+*/
+template<typename Table>
+long long runTable(Table &table, const int threads, const int ops,
+                   const int keys, const int readRatio) {
+    std::atomic<long long> hits(0);
+    vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            XorShift rng(t + 1);
+            long long localHits = 0;
+            for (int i = 0; i < ops; ++i) {
+                const std::uint64_t r = rng.next();
+                const long long key = (long long)((r >> 32) % keys);
+                const int op = (int)((r & 0xFFFF) % 200);
+                if (op < 2 * readRatio) {
+                    localHits += table.has(key);
+                } else if (op & 1) {
+                    localHits += table.insert(key);
+                } else {
+                    localHits += table.remove(key);
+                }
+            }
+            hits += localHits;
+        });
+    }
+    for (auto &th : pool) {
+        th.join();
+    }
+    return hits;
+}
+
+template<typename Table>
+void fill(Table &table, const int keys) {
+    for (int i = 0; i < keys; i += 2) {
+        table.insert(i);
+    }
+}
+
+int main() {
+    printLn("Benchmark of ConcurrentHashTable running...\n");
+    {
+        const int KEYS = 1000000;
+        const int TOTAL_OPS = 4000000;
+        const int THREADS[] = {1, 2, 4, 8, 16, 32, 64};
+        const int READ_RATIOS[] = {50, 90, 99};
+        printLn("Hardware concurrency: " + toString(std::thread::hardware_concurrency()));
+        printLn("Distinct keys: " + toString(KEYS) + ", operations: " + toString(TOTAL_OPS) + "\n");
+        for (int readRatio : READ_RATIOS) {
+            printLn("Lookups: " + toString(readRatio) + "%");
+            for (int threads : THREADS) {
+                const int ops = TOTAL_OPS / threads;
+                long long lockHits = 0, shardHits = 0;
+                double lockTime, shardTime;
+                {
+                    LockedTable table;
+                    fill(table, KEYS);
+                    lockTime = wallTiming([&]() {
+                        lockHits = runTable(table, threads, ops, KEYS, readRatio);
+                    });
+                }
+                {
+                    ConcurrentHashTable<long long> table;
+                    fill(table, KEYS);
+                    shardTime = wallTiming([&]() {
+                        shardHits = runTable(table, threads, ops, KEYS, readRatio);
+                    });
+                }
+                const double total = (double)ops * threads;
+                printLn("Threads: " + toString(threads)
+                        + ", mutex + HashTable VS ConcurrentHashTable: "
+                        + toString(total / lockTime / 1000) + " M ops/s / "
+                        + toString(total / shardTime / 1000) + " M ops/s (hits "
+                        + toString(lockHits) + " / " + toString(shardHits) + ")");
+            }
+            printLn("");
+        }
+    }
+    printLn("Benchmark of ConcurrentHashTable finished.");
+    checkMemoryLeaks();
+    return 0;
+}
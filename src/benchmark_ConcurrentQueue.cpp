@@ -0,0 +1,117 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/ConcurrentQueue.h"
+#include "tastylib/DoublyLinkedList.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+/*
+A FIFO queue made of a DoublyLinkedList guarded by a mutex.
+*/
+class LockedQueue {
+public:
+    bool tryPush(const long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        list.insertBack(val);
+        return true;
+    }
+
+    bool tryPop(long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (list.isEmpty()) {
+            return false;
+        }
+        val = *list.begin();
+        list.removeFront();
+        return true;
+    }
+
+private:
+    std::mutex mtx;
+    DoublyLinkedList<long long> list;
+};
+
+/*
+Hand a given amount of values from producer threads to consumer threads.
+
+@param queue     The queue to run
+@param producers The amount of producer threads
+@param consumers The amount of consumer threads
+@param total     The amount of values to hand over
+@return          The sum of all popped values.
+*/
+template<typename Queue>
+long long runQueue(Queue &queue, const int producers, const int consumers, const int total) {
+    std::atomic<int> left(total);
+    std::atomic<long long> sum(0);
+    vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = p; i < total; i += producers) {
+                while (!queue.tryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            long long val, localSum = 0;
+            while (left.load(std::memory_order_relaxed) > 0) {
+                if (queue.tryPop(val)) {
+                    localSum += val;
+                    left.fetch_sub(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += localSum;
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    return sum;
+}
+
+int main() {
+    printLn("Benchmark of ConcurrentQueue running...\n");
+    {
+        const int TOTAL = 4000000;
+        const int CAPACITY = 1024;
+        const int THREADS[] = {1, 2, 4, 8};
+        const long long expectSum = (long long)TOTAL * (TOTAL - 1) / 2;
+        printLn("Hardware concurrency: " + toString(std::thread::hardware_concurrency()));
+        printLn("Handing " + toString(TOTAL) + " values from producers to consumers...\n");
+        for (int producers : THREADS) {
+            for (int consumers : THREADS) {
+                printLn("Producers: " + toString(producers) + ", consumers: " + toString(consumers));
+                long long lockSum = 0, freeSum = 0;
+                auto lockTime = wallTiming([&]() {
+                    LockedQueue queue;
+                    lockSum = runQueue(queue, producers, consumers, TOTAL);
+                });
+                auto freeTime = wallTiming([&]() {
+                    ConcurrentQueue<long long> queue(CAPACITY);
+                    freeSum = runQueue(queue, producers, consumers, TOTAL);
+                });
+                bool correct = lockSum == expectSum && freeSum == expectSum;
+                printLn("Correctness check: " + string(correct ? "pass" : "fail"));
+                printLn("Throughput of mutex + DoublyLinkedList VS ConcurrentQueue: "
+                        + toString(TOTAL / lockTime / 1000) + " M/s / "
+                        + toString(TOTAL / freeTime / 1000) + " M/s\n");
+            }
+        }
+    }
+    printLn("Benchmark of ConcurrentQueue finished.");
+    checkMemoryLeaks();
+    return 0;
+}
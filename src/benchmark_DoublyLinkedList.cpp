@@ -3,8 +3,16 @@
 #include "tastylib/util/convert.h"
 #include "tastylib/util/random.h"
 #include "tastylib/DoublyLinkedList.h"
+#include "tastylib/ArrayLinkedList.h"
+#include "tastylib/UnrolledLinkedList.h"
+#include "tastylib/IndexableSkipList.h"
+#include "tastylib/ChunkedDeque.h"
 #include <list>
+#include <deque>
 #include <algorithm>
+#include <iterator>
+#include <vector>
+#include <thread>
 
 using namespace tastylib;
 using std::string;
@@ -16,9 +24,8 @@ typedef DoublyLinkedList<int>::SizeType SizeType;
 If the contents of the two lists are the same, print
 passing message. Otherwise print failing message.
 */
-template<typename T>
-void checkCorrect(const std::list<T> &stdList,
-                  const DoublyLinkedList<T> &libList) {
+template<typename T, typename List>
+void checkCorrect(const std::list<T> &stdList, const List &libList) {
     bool correct = true;
     if (stdList.size() != libList.getSize()) {
         correct = false;
@@ -43,6 +50,10 @@ int main() {
         const int SIZE_SORT = 5000000;
         const int SIZE_FIND = 100000;
         const int SIZE_OTHER = 40000000;
+        const int SIZE_CHURN = 1000000;
+        const int OPS_CHURN = 10000000;
+        const int OPS_CHURN_POS = 2000;
+        const int OPS_SKIP = 1000000;
         list<int> stdList;
         DoublyLinkedList<int> libList;
 
@@ -208,6 +219,510 @@ int main() {
                     + toString(libTot / CASES_SORT) + " ms");
             printLn("Benchmark of sort() finished.\n");
         }
+
+        {   // Benchmark sort() on presorted inputs
+            printLn("Benchmarking sort() on presorted inputs...");
+            const char *names[] = {"ascending", "descending", "nearly sorted"};
+            for (int k = 0; k < 3; ++k) {
+                stdList.clear();
+                libList.clear();
+                printLn("Inserting " + toString(SIZE_SORT) + " " + names[k] + " elements to the list...");
+                for (int i = 0; i < SIZE_SORT; ++i) {
+                    int e = (k == 1 ? SIZE_SORT - i : i);
+                    if (k == 2 && randInt(0, 99) == 0) {
+                        e = randInt(0, SIZE_SORT - 1);
+                    }
+                    stdList.push_back(e);
+                    libList.insertBack(e);
+                }
+                auto stdTime = timing([&]() {
+                    stdList.sort();
+                });
+                auto libTime = timing([&]() {
+                    libList.sort();
+                });
+                checkCorrect(stdList, libList);
+                printLn("Time of std VS TastyLib (" + std::string(names[k]) + "): "
+                        + toString(stdTime) + " ms / " + toString(libTime) + " ms");
+            }
+            printLn("Benchmark of sort() on presorted inputs finished.\n");
+        }
+
+        {   // Benchmark multi-threaded sort()
+            unsigned maxThreads = std::thread::hardware_concurrency();
+            maxThreads = (maxThreads < 1 ? 1 : maxThreads);
+            printLn("Benchmarking multi-threaded sort() with 1 to " + toString(maxThreads) + " threads...");
+            std::vector<int> vals;
+            for (int i = 0; i < SIZE_SORT; ++i) {
+                vals.push_back(randInt(0, SIZE_SORT - 1));
+            }
+            double baseTime = 0;
+            for (unsigned threadNum = 1; ; threadNum = std::min(threadNum * 2, maxThreads)) {
+                libList.clear();
+                for (const auto &e : vals) {
+                    libList.insertBack(e);
+                }
+                auto libTime = wallTiming([&]() {
+                    libList.sort(std::less<int>(), threadNum);
+                });
+                baseTime = (threadNum == 1 ? libTime : baseTime);
+                printLn("Threads: " + toString(threadNum) + ", wall time: " + toString(libTime)
+                        + " ms, speedup: " + toString(baseTime / libTime));
+                if (threadNum == maxThreads) {
+                    break;
+                }
+            }
+            stdList.assign(vals.begin(), vals.end());
+            stdList.sort();
+            checkCorrect(stdList, libList);
+            printLn("Benchmark of multi-threaded sort() finished.\n");
+        }
+
+        {   // Benchmark insert()/erase() with iterators
+            printLn("Benchmarking insert()/erase() in the middle of the list...");
+            stdList.clear();
+            libList.clear();
+            printLn("Inserting " + toString(SIZE_CHURN) + " elements to the list...");
+            for (int i = 0; i < SIZE_CHURN; ++i) {
+                stdList.push_back(i);
+                libList.insertBack(i);
+            }
+            printLn("Finished.");
+
+            // Erase a node and insert a new one at the middle
+            printLn("Erasing and inserting " + toString(OPS_CHURN) + " elements by iterators...");
+            auto stdTime = timing([&]() {
+                auto it = stdList.begin();
+                std::advance(it, SIZE_CHURN / 2);
+                for (int i = 0; i < OPS_CHURN; ++i) {
+                    it = stdList.erase(it);
+                    it = stdList.insert(it, i);
+                }
+            });
+            printLn("std finished.");
+            auto libTime = timing([&]() {
+                auto it = libList.begin();
+                std::advance(it, SIZE_CHURN / 2);
+                for (int i = 0; i < OPS_CHURN; ++i) {
+                    it = libList.erase(it);
+                    it = libList.insert(it, i);
+                }
+            });
+            printLn("lib finished.");
+            checkCorrect(stdList, libList);
+            printLn("Avg time of std VS TastyLib: " + toString(stdTime / OPS_CHURN) + " ms / "
+                    + toString(libTime / OPS_CHURN) + " ms");
+
+            // The same workload through positions, which walks the list
+            printLn("Removing and inserting " + toString(OPS_CHURN_POS) + " elements by positions...");
+            auto posTime = timing([&]() {
+                for (int i = 0; i < OPS_CHURN_POS; ++i) {
+                    libList.remove(SIZE_CHURN / 2);
+                    libList.insert(SIZE_CHURN / 2, i);
+                }
+            });
+            printLn("lib finished.");
+            printLn("Avg time of TastyLib by positions: " + toString(posTime / OPS_CHURN_POS) + " ms");
+            printLn("Benchmark of insert()/erase() finished.\n");
+        }
+
+        {   // Benchmark random positional edits with IndexableSkipList
+            printLn("Benchmarking random positional edits with IndexableSkipList...");
+            IndexableSkipList<int> skipList;
+            libList.clear();
+            printLn("Inserting " + toString(SIZE_CHURN) + " elements to the lists...");
+            for (int i = 0; i < SIZE_CHURN; ++i) {
+                libList.insertBack(i);
+                skipList.insertBack(i);
+            }
+            printLn("Finished.");
+
+            // Sequential traversal
+            long long sum = 0;
+            auto libTime = timing([&]() {
+                for (const auto &e : libList) {
+                    sum += e;
+                }
+            });
+            auto skipTime = timing([&]() {
+                for (const auto &e : skipList) {
+                    sum += e;
+                }
+            });
+            printLn("Time of traversal of DoublyLinkedList VS IndexableSkipList: " + toString(libTime)
+                    + " ms / " + toString(skipTime) + " ms");
+
+            // Remove a node and insert a new one at random positions
+            std::vector<int> poses;
+            for (int i = 0; i < OPS_SKIP; ++i) {
+                poses.push_back(randInt(0, SIZE_CHURN - 1));
+            }
+            printLn("Removing and inserting " + toString(OPS_CHURN_POS) + " elements at random positions...");
+            libTime = timing([&]() {
+                for (int i = 0; i < OPS_CHURN_POS; ++i) {
+                    libList.remove(poses[i]);
+                    libList.insert(poses[OPS_SKIP - 1 - i], i);
+                }
+            });
+            printLn("DoublyLinkedList finished.");
+            printLn("Removing and inserting " + toString(OPS_SKIP) + " elements at random positions...");
+            skipTime = timing([&]() {
+                for (int i = 0; i < OPS_SKIP; ++i) {
+                    skipList.remove(poses[i]);
+                    skipList.insert(poses[OPS_SKIP - 1 - i], i);
+                }
+            });
+            printLn("IndexableSkipList finished.");
+            printLn("Avg time of DoublyLinkedList VS IndexableSkipList: " + toString(libTime / OPS_CHURN_POS)
+                    + " ms / " + toString(skipTime / OPS_SKIP) + " ms");
+
+            // Random positional lookups
+            skipTime = timing([&]() {
+                for (int i = 0; i < OPS_SKIP; ++i) {
+                    sum += skipList.at(poses[i]);
+                }
+            });
+            printLn("Avg time of IndexableSkipList at(): " + toString(skipTime / OPS_SKIP)
+                    + " ms (checksum " + toString(sum) + ")");
+            printLn("Benchmark of random positional edits finished.\n");
+        }
+    }
+    {   // Compare ArrayLinkedList with DoublyLinkedList
+        const int SIZE_FIND = 100000;
+        const int SIZE_OTHER = 40000000;
+        list<int> stdList;
+        DoublyLinkedList<int> libList;
+        ArrayLinkedList<int> arrList;
+        printLn("Benchmarking ArrayLinkedList...");
+        printLn("Node size of DoublyLinkedList VS ArrayLinkedList: "
+                + toString(sizeof(DoublyLinkedList<int>::Node)) + " bytes / "
+                + toString(sizeof(ArrayLinkedList<int>::Node)) + " bytes");
+
+        // Print the average time of a workload run on both lists
+        auto compare = [&](const string &name, const int ops,
+                           const std::function<void()> &stdOp,
+                           const std::function<void()> &libOp,
+                           const std::function<void()> &arrOp) {
+            printLn("Benchmarking " + name + " with " + toString(ops) + " operations...");
+            stdOp();
+            auto libTime = timing(libOp);
+            printLn("DoublyLinkedList finished.");
+            auto arrTime = timing(arrOp);
+            printLn("ArrayLinkedList finished.");
+            checkCorrect(stdList, libList);
+            checkCorrect(stdList, arrList);
+            printLn("Avg time of DoublyLinkedList VS ArrayLinkedList: " + toString(libTime / ops)
+                    + " ms / " + toString(arrTime / ops) + " ms\n");
+        };
+
+        compare("insertBack()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdList.push_back(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.insertBack(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                arrList.insertBack(i);
+            }
+        });
+        compare("removeFront()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdList.pop_front();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.removeFront();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                arrList.removeFront();
+            }
+        });
+        compare("insertFront()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdList.push_front(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.insertFront(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                arrList.insertFront(i);
+            }
+        });
+        compare("removeBack()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdList.pop_back();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.removeBack();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                arrList.removeBack();
+            }
+        });
+
+        for (int i = 0; i < SIZE_FIND; ++i) {
+            int val = randInt(0, SIZE_FIND << 2);
+            stdList.push_back(val);
+            libList.insertBack(val);
+            arrList.insertBack(val);
+        }
+        int dontCare = 0;  // Suppress compiler optimization
+        compare("find()", SIZE_FIND, [&]() {}, [&]() {
+            for (const auto &x : stdList) {
+                dontCare += libList.find(x);
+            }
+        }, [&]() {
+            for (const auto &x : stdList) {
+                dontCare += arrList.find(x);
+            }
+        });
+        compare("sort()", 1, [&]() { stdList.sort(); },
+                [&]() { libList.sort(); }, [&]() { arrList.sort(); });
+        UNUSED(dontCare);
+        printLn("Benchmark of ArrayLinkedList finished.\n");
+    }
+    {   // Compare UnrolledLinkedList with DoublyLinkedList
+        const int SIZE_TRAVERSE = 10000000;
+        const int CASES_TRAVERSE = 10;
+        const int SIZE_POS = 100000;
+        const int OPS_POS = 20000;
+        DoublyLinkedList<int> libList;
+        UnrolledLinkedList<int> unrList;
+        printLn("Benchmarking UnrolledLinkedList...");
+
+        {   // Benchmark traversal
+            printLn("Inserting " + toString(SIZE_TRAVERSE) + " elements to the list...");
+            for (int i = 0; i < SIZE_TRAVERSE; ++i) {
+                libList.insertBack(i);
+                unrList.insertBack(i);
+            }
+            printLn("Traversing the list for " + toString(CASES_TRAVERSE) + " times...");
+            long long libSum = 0, unrSum = 0;
+            auto libTime = timing([&]() {
+                for (int i = 0; i < CASES_TRAVERSE; ++i) {
+                    libList.traverse([&](const SizeType pos, const int &val) {
+                        UNUSED(pos);
+                        libSum += val;
+                    });
+                }
+            });
+            printLn("DoublyLinkedList finished.");
+            auto unrTime = timing([&]() {
+                for (int i = 0; i < CASES_TRAVERSE; ++i) {
+                    unrList.traverse([&](const SizeType pos, const int &val) {
+                        UNUSED(pos);
+                        unrSum += val;
+                    });
+                }
+            });
+            printLn("UnrolledLinkedList finished.");
+            printLn("Correctness check: " + string(libSum == unrSum ? "pass" : "fail"));
+            const double cnt = (double)SIZE_TRAVERSE * CASES_TRAVERSE;
+            printLn("traverse() throughput of DoublyLinkedList VS UnrolledLinkedList: "
+                    + toString(cnt / libTime) + " elements/ms / "
+                    + toString(cnt / unrTime) + " elements/ms");
+
+            // Find a missing value, which scans the whole list
+            int libPos = 0, unrPos = 0;
+            libTime = timing([&]() {
+                for (int i = 0; i < CASES_TRAVERSE; ++i) {
+                    libPos += libList.find(-1);
+                }
+            });
+            unrTime = timing([&]() {
+                for (int i = 0; i < CASES_TRAVERSE; ++i) {
+                    unrPos += unrList.find(-1);
+                }
+            });
+            printLn("Correctness check: " + string(libPos == unrPos ? "pass" : "fail"));
+            printLn("find() throughput of DoublyLinkedList VS UnrolledLinkedList: "
+                    + toString(cnt / libTime) + " elements/ms / "
+                    + toString(cnt / unrTime) + " elements/ms");
+        }
+
+        {   // Benchmark insert()/remove() at random positions
+            libList.clear();
+            unrList.clear();
+            printLn("Inserting " + toString(SIZE_POS) + " elements to the list...");
+            for (int i = 0; i < SIZE_POS; ++i) {
+                libList.insertBack(i);
+                unrList.insertBack(i);
+            }
+            std::vector<SizeType> poses;
+            for (int i = 0; i < OPS_POS; ++i) {
+                poses.push_back(randInt<SizeType>(0, SIZE_POS - 1));
+            }
+            printLn("Inserting and removing " + toString(OPS_POS) + " elements at random positions...");
+            auto libTime = timing([&]() {
+                for (int i = 0; i < OPS_POS; ++i) {
+                    libList.insert(poses[i], i);
+                    libList.remove(poses[OPS_POS - 1 - i]);
+                }
+            });
+            printLn("DoublyLinkedList finished.");
+            auto unrTime = timing([&]() {
+                for (int i = 0; i < OPS_POS; ++i) {
+                    unrList.insert(poses[i], i);
+                    unrList.remove(poses[OPS_POS - 1 - i]);
+                }
+            });
+            printLn("UnrolledLinkedList finished.");
+            bool correct = true;
+            std::vector<int> libVals;
+            libList.traverse([&](const SizeType pos, const int &val) {
+                UNUSED(pos);
+                libVals.push_back(val);
+            });
+            unrList.traverse([&](const SizeType pos, const int &val) {
+                correct = correct && libVals[pos] == val;
+            });
+            printLn("Correctness check: " + string(correct ? "pass" : "fail"));
+            printLn("Avg time of DoublyLinkedList VS UnrolledLinkedList: " + toString(libTime / OPS_POS)
+                    + " ms / " + toString(unrTime / OPS_POS) + " ms");
+        }
+        printLn("Benchmark of UnrolledLinkedList finished.\n");
+    }
+    {   // Compare ChunkedDeque with std::deque and DoublyLinkedList
+        const int SIZE_OTHER = 40000000;
+        const int SIZE_FIFO = 1000;
+        const int SIZE_INDEX = 1000000;
+        std::deque<int> stdDeque;
+        DoublyLinkedList<int> libList;
+        ChunkedDeque<int> chkDeque;
+        printLn("Benchmarking ChunkedDeque...");
+
+        // Print the average time of a workload run on the three containers
+        auto compare = [&](const string &name, const int ops,
+                           const std::function<void()> &stdOp,
+                           const std::function<void()> &libOp,
+                           const std::function<void()> &chkOp) {
+            printLn("Benchmarking " + name + " with " + toString(ops) + " operations...");
+            auto stdTime = timing(stdOp);
+            printLn("std::deque finished.");
+            auto libTime = timing(libOp);
+            printLn("DoublyLinkedList finished.");
+            auto chkTime = timing(chkOp);
+            printLn("ChunkedDeque finished.");
+            bool correct = stdDeque.size() == chkDeque.getSize()
+                           && stdDeque.size() == libList.getSize();
+            chkDeque.traverse([&](const SizeType pos, const int &val) {
+                correct = correct && stdDeque[pos] == val;
+            });
+            printLn("Correctness check: " + string(correct ? "pass" : "fail"));
+            printLn("Avg time of std::deque VS DoublyLinkedList VS ChunkedDeque: " + toString(stdTime / ops)
+                    + " ms / " + toString(libTime / ops) + " ms / " + toString(chkTime / ops) + " ms\n");
+        };
+
+        compare("insertFront()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdDeque.push_front(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.insertFront(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                chkDeque.insertFront(i);
+            }
+        });
+        compare("removeFront()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdDeque.pop_front();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.removeFront();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                chkDeque.removeFront();
+            }
+        });
+        compare("insertBack()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdDeque.push_back(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.insertBack(i);
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                chkDeque.insertBack(i);
+            }
+        });
+        compare("removeBack()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdDeque.pop_back();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.removeBack();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                chkDeque.removeBack();
+            }
+        });
+
+        // A FIFO queue whose size stays around SIZE_FIFO
+        for (int i = 0; i < SIZE_FIFO; ++i) {
+            stdDeque.push_back(i);
+            libList.insertBack(i);
+            chkDeque.insertBack(i);
+        }
+        compare("FIFO insertBack() + removeFront()", SIZE_OTHER, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                stdDeque.push_back(i);
+                stdDeque.pop_front();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                libList.insertBack(i);
+                libList.removeFront();
+            }
+        }, [&]() {
+            for (int i = 0; i < SIZE_OTHER; ++i) {
+                chkDeque.insertBack(i);
+                chkDeque.removeFront();
+            }
+        });
+
+        // Random access by index
+        stdDeque.clear();
+        chkDeque.clear();
+        for (int i = 0; i < SIZE_INDEX; ++i) {
+            stdDeque.push_back(i);
+            chkDeque.insertBack(i);
+        }
+        std::vector<int> poses;
+        for (int i = 0; i < SIZE_INDEX; ++i) {
+            poses.push_back(randInt(0, SIZE_INDEX - 1));
+        }
+        long long stdSum = 0, chkSum = 0;
+        auto stdTime = timing([&]() {
+            for (const auto &p : poses) {
+                stdSum += stdDeque[p];
+            }
+        });
+        auto chkTime = timing([&]() {
+            for (const auto &p : poses) {
+                chkSum += chkDeque[p];
+            }
+        });
+        printLn("Correctness check: " + string(stdSum == chkSum ? "pass" : "fail"));
+        printLn("Avg time of operator[] of std::deque VS ChunkedDeque: " + toString(stdTime / SIZE_INDEX)
+                + " ms / " + toString(chkTime / SIZE_INDEX) + " ms");
+        printLn("Benchmark of ChunkedDeque finished.\n");
     }
     printLn("Benchmark of DoublyLinkedList finished.");
     checkMemoryLeaks();
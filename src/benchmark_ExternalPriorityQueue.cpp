@@ -0,0 +1,101 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/ExternalPriorityQueue.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+struct Event {
+    long long time;
+    long long id;
+};
+
+struct EventGreaterEqual {
+    bool operator()(const Event &a, const Event &b) const {
+        return a.time >= b.time;
+    }
+};
+
+/*
+Remove the earliest event of a queue and return it.
+*/
+Event popEvent(BinaryHeap<Event, EventGreaterEqual> &queue) {
+    return queue.popTop();
+}
+
+Event popEvent(ExternalPriorityQueue<Event, EventGreaterEqual> &queue) {
+    Event e{0, 0};
+    if (!queue.popTop(e)) {
+        printLn("Error: a run cannot be read");
+        std::exit(1);
+    }
+    return e;
+}
+
+/*
+Run an event backlog on a queue: push the initial events, then pop the
+earliest event and push a later one for a given amount of times, and
+finally pop all events.
+
+@return The sum of the popped times.
+*/
+template<typename Queue>
+long long runBacklog(Queue &queue, const vector<long long> &times,
+                     const vector<int> &delays, const int steps) {
+    long long sum = 0;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        queue.push(Event{times[i], (long long)i});
+    }
+    for (int i = 0; i < steps; ++i) {
+        Event e = popEvent(queue);
+        sum += e.time;
+        queue.push(Event{e.time + delays[i % delays.size()], e.id});
+    }
+    while (!queue.isEmpty()) {
+        sum += popEvent(queue).time;
+    }
+    return sum;
+}
+
+int main() {
+    printLn("Benchmark of ExternalPriorityQueue running...\n");
+    {
+        const std::size_t BUDGET = 32 << 20;
+        const int SIZE = (int)(BUDGET * 10 / sizeof(Event));  // 10 times the budget
+        const int STEPS = SIZE;
+        vector<long long> times;
+        times.reserve(SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            times.push_back(randInt(0, 1 << 30));
+        }
+        vector<int> delays;
+        for (int i = 0; i < 1 << 20; ++i) {
+            delays.push_back(randInt(0, 1 << 20));
+        }
+        printLn("Memory budget: " + toString(BUDGET >> 20) + " MB, elements: " + toString(SIZE)
+                + " (" + toString(SIZE * sizeof(Event) >> 20) + " MB), pop-push pairs: "
+                + toString(STEPS));
+        long long heapSum = 0, extSum = 0;
+        auto heapTime = timing([&]() {
+            BinaryHeap<Event, EventGreaterEqual> queue;
+            heapSum = runBacklog(queue, times, delays, STEPS);
+        });
+        auto extTime = timing([&]() {
+            ExternalPriorityQueue<Event, EventGreaterEqual> queue(BUDGET);
+            extSum = runBacklog(queue, times, delays, STEPS);
+        });
+        printLn("Total time of BinaryHeap (in memory) VS ExternalPriorityQueue: "
+                + toString(heapTime) + " ms / " + toString(extTime) + " ms");
+        printLn("Correctness check: " + string(heapSum == extSum ? "pass" : "fail") + "\n");
+    }
+    printLn("Benchmark of ExternalPriorityQueue finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/Hash.h"
+#include "tastylib/HashTable.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+/*
+The 64-bit FNV-1a hash, which StringHash used before.
+*/
+std::uint64_t fnv1a(const char *p, const std::size_t len) {
+    std::uint64_t h = 0xCBF29CE484222325ull;
+    for (std::size_t i = 0; i < len; ++i) {
+        h = (h ^ (unsigned char)p[i]) * 0x100000001B3ull;
+    }
+    return h;
+}
+
+/*
+Put the hash values into buckets selected by their low bits, as
+HashTable does, and print how evenly they are spread.
+
+@param name   The name of the hash function and the keys
+@param hashes The hash values
+@param bits   The amount of low bits that select the bucket
+*/
+void printSpread(const string &name, const vector<std::uint64_t> &hashes, const int bits) {
+    const std::size_t num = (std::size_t)1 << bits;
+    vector<std::size_t> cnt(num, 0);
+    for (const auto &h : hashes) {
+        ++cnt[h & (num - 1)];
+    }
+    std::size_t used = 0, maxLen = 0;
+    double probes = 0;
+    for (const auto &c : cnt) {
+        used += c > 0;
+        maxLen = c > maxLen ? c : maxLen;
+        probes += (double)c * (c + 1) / 2;
+    }
+    printLn(name + ": buckets used " + toString(100.0 * used / num) + "%, longest chain "
+            + toString(maxLen) + ", mean comparisons per hit " + toString(probes / hashes.size()));
+}
+
+/*
+Hash strings of a given length repeatedly and print the throughput.
+
+@param name The name of the hash function
+@param strs The strings
+@param f    The hash function
+*/
+void printSpeed(const string &name, const vector<string> &strs,
+                const std::function<std::uint64_t(const string&)> &f) {
+    const std::size_t TOTAL_BYTES = 1 << 28;
+    const std::size_t rounds = TOTAL_BYTES / (strs.size() * strs[0].size()) + 1;
+    std::uint64_t sum = 0;
+    auto time = timing([&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (const auto &s : strs) {
+                sum += f(s);
+            }
+        }
+    });
+    const double bytes = (double)rounds * strs.size() * strs[0].size();
+    const double calls = (double)rounds * strs.size();
+    printLn(name + ": " + toString(bytes / time / 1e6) + " GB/s, "
+            + toString(time * 1e6 / calls) + " ns/hash (checksum " + toString(sum % 1000) + ")");
+}
+
+template<typename Table>
+double runTable(Table &table, const vector<long long> &keys) {
+    return timing([&]() {
+        for (const auto &k : keys) {
+            table.insert(k);
+        }
+        for (const auto &k : keys) {
+            if (!table.has(k)) {
+                printLn("Error: key not found");
+            }
+        }
+    });
+}
+
+int main() {
+    printLn("Benchmark of Hash running...\n");
+    {   // Spread of the hash values in 2^20 buckets
+        const int BITS = 20;
+        const std::size_t N = (std::size_t)1 << BITS;
+        printLn("Spread of " + toString(N) + " keys in " + toString(N) + " buckets "
+                + "(ideal: 63.2% used, 1.5 comparisons per hit)");
+        const int STRIDES[] = {1, 64, 4096};
+        for (int stride : STRIDES) {
+            vector<std::uint64_t> id, mixed;
+            for (std::size_t i = 0; i < N; ++i) {
+                const long long key = (long long)i * stride;
+                id.push_back(std::hash<long long>()(key));
+                mixed.push_back(Hasher<long long>()(key));
+            }
+            printSpread("Integers of stride " + toString(stride) + ", std::hash", id, BITS);
+            printSpread("Integers of stride " + toString(stride) + ", Hasher", mixed, BITS);
+        }
+        vector<std::uint64_t> stdHashes, fnv, mixed;
+        for (std::size_t i = 0; i < N; ++i) {
+            const string key = "session-token-" + toString(i);
+            stdHashes.push_back(std::hash<string>()(key));
+            fnv.push_back(fnv1a(key.data(), key.size()));
+            mixed.push_back(Hasher<string>()(key));
+        }
+        printSpread("Strings, std::hash", stdHashes, BITS);
+        printSpread("Strings, FNV-1a", fnv, BITS);
+        printSpread("Strings, Hasher", mixed, BITS);
+        printLn("");
+    }
+    {   // Hashing speed
+        const std::size_t LENS[] = {8, 16, 32, 64, 256, 4096, 1 << 20};
+        for (std::size_t len : LENS) {
+            vector<string> strs;
+            const std::size_t cnt = len >= 4096 ? 4 : 1024;
+            for (std::size_t i = 0; i < cnt; ++i) {
+                string s(len, 'a');
+                for (std::size_t j = 0; j < len; ++j) {
+                    s[j] = (char)('a' + (i * 31 + j * 7) % 26);
+                }
+                strs.push_back(s);
+            }
+            printLn("Strings of " + toString(len) + " bytes:");
+            printSpeed("std::hash", strs, [](const string &s) {
+                return (std::uint64_t)std::hash<string>()(s);
+            });
+            printSpeed("FNV-1a   ", strs, [](const string &s) {
+                return fnv1a(s.data(), s.size());
+            });
+            printSpeed("hashBytes", strs, [](const string &s) {
+                return hashBytes(s.data(), s.size());
+            });
+        }
+        const std::uint64_t N = 200000000;
+        std::uint64_t sum = 0;
+        auto time = timing([&]() {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                sum += mixInt(i);
+            }
+        });
+        printLn("mixInt: " + toString(time * 1e6 / N) + " ns/hash (checksum "
+                + toString(sum % 1000) + ")\n");
+    }
+    {   // HashTable with strided integer keys
+        const int N = 100000;
+        const int STRIDES[] = {1, 4096};
+        for (int stride : STRIDES) {
+            vector<long long> keys;
+            for (int i = 0; i < N; ++i) {
+                keys.push_back((long long)i * stride);
+            }
+            HashTable<long long, std::equal_to<long long>, std::hash<long long>> idTable;
+            HashTable<long long> mixedTable;
+            const double idTime = runTable(idTable, keys);
+            const double mixedTime = runTable(mixedTable, keys);
+            printLn("HashTable, " + toString(N) + " keys of stride " + toString(stride)
+                    + ", std::hash VS Hasher: " + toString(idTime) + " ms / "
+                    + toString(mixedTime) + " ms");
+        }
+    }
+    printLn("\nBenchmark of Hash finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/string_ref.h"
+#include "tastylib/HashMap.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+int main() {
+    printLn("Benchmark of HashMap running...\n");
+    {
+        const int KEY_NUM = 1000000;
+        const int TOKEN_NUM = 10000000;
+        // The keys are longer than the small string buffer of std::string,
+        // so constructing a std::string from a token allocates
+        string text;
+        vector<std::size_t> offsets;
+        for (int i = 0; i < KEY_NUM; ++i) {
+            offsets.push_back(text.size());
+            text += "session-token-" + toString(i);
+        }
+        offsets.push_back(text.size());
+        vector<int> tokens;
+        tokens.reserve(TOKEN_NUM);
+        for (int i = 0; i < TOKEN_NUM; ++i) {
+            // Each key appears at least once
+            tokens.push_back(i < KEY_NUM ? i : randInt(0, KEY_NUM - 1));
+        }
+        randChange(tokens);
+        auto tokenRef = [&](const int k) {
+            return StringRef(text.data() + offsets[k], offsets[k + 1] - offsets[k]);
+        };
+        printLn("Counting " + toString(TOKEN_NUM) + " tokens of " + toString(KEY_NUM)
+                + " distinct strings in a text buffer...");
+        long long sum1 = 0, sum2 = 0, sum3 = 0;
+        auto stdTime = timing([&]() {
+            std::unordered_map<string, int> map;
+            for (const auto &k : tokens) {
+                ++map[string(tokenRef(k))];
+            }
+            for (int k = 0; k < KEY_NUM; ++k) {
+                sum1 += map.find(string(tokenRef(k)))->second;
+            }
+        });
+        auto mapTime = timing([&]() {
+            HashMap<string, int> map;
+            for (const auto &k : tokens) {
+                ++map[string(tokenRef(k))];
+            }
+            for (int k = 0; k < KEY_NUM; ++k) {
+                sum2 += *map.find(string(tokenRef(k)));
+            }
+        });
+        auto refTime = timing([&]() {
+            HashMap<string, int, StringEqual, StringHash> map;
+            for (const auto &k : tokens) {
+                ++map[tokenRef(k)];
+            }
+            for (int k = 0; k < KEY_NUM; ++k) {
+                sum3 += *map.find(tokenRef(k));
+            }
+        });
+        printLn("Total time of std::unordered_map VS HashMap (std::string lookup) VS HashMap (StringRef lookup): "
+                + toString(stdTime) + " ms / " + toString(mapTime) + " ms / " + toString(refTime) + " ms");
+        bool pass = sum1 == TOKEN_NUM && sum2 == TOKEN_NUM && sum3 == TOKEN_NUM;
+        printLn("Correctness check: " + string(pass ? "pass" : "fail") + "\n");
+    }
+    printLn("Benchmark of HashMap finished.");
+    checkMemoryLeaks();
+    return 0;
+}
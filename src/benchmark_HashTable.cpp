@@ -0,0 +1,178 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/HashTable.h"
+#include "tastylib/FlatHashTable.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef unsigned long long Key;
+
+void insertKey(std::unordered_set<Key> &table, const Key key) {
+    table.insert(key);
+}
+
+bool hasKey(const std::unordered_set<Key> &table, const Key key) {
+    return table.count(key) > 0;
+}
+
+void removeKey(std::unordered_set<Key> &table, const Key key) {
+    table.erase(key);
+}
+
+template<typename Table>
+void insertKey(Table &table, const Key key) {
+    table.insert(key);
+}
+
+template<typename Table>
+bool hasKey(const Table &table, const Key key) {
+    return table.has(key);
+}
+
+template<typename Table>
+void removeKey(Table &table, const Key key) {
+    table.remove(key);
+}
+
+/*
+Time the operations on a table and print the results
+in nanoseconds per operation.
+
+@param name   The name of the table
+@param table  The empty table
+@param keys   The keys to be inserted and removed
+@param hits   The keys to be looked up, which are the same as 'keys'
+              in another order, so that the lookups do not follow
+              the order of allocation
+@param misses The keys not in the table
+@return       The amount of keys found, for the correctness check
+*/
+template<typename Table>
+std::size_t run(const string &name, Table &table, const vector<Key> &keys,
+                const vector<Key> &hits, const vector<Key> &misses) {
+    const double n = (double)keys.size();
+    std::size_t found = 0;
+    auto insertTime = timing([&]() {
+        for (const auto &k : keys) {
+            insertKey(table, k);
+        }
+    });
+    auto hitTime = timing([&]() {
+        for (const auto &k : hits) {
+            found += hasKey(table, k);
+        }
+    });
+    auto missTime = timing([&]() {
+        for (const auto &k : misses) {
+            found += hasKey(table, k);
+        }
+    });
+    auto removeTime = timing([&]() {
+        for (const auto &k : keys) {
+            removeKey(table, k);
+        }
+    });
+    printLn(name + ": insert " + toString(insertTime * 1e6 / n) + " ns, has (hit) "
+            + toString(hitTime * 1e6 / n) + " ns, has (miss) "
+            + toString(missTime * 1e6 / n) + " ns, remove "
+            + toString(removeTime * 1e6 / n) + " ns");
+    return found;
+}
+
+/*
+Time each insertion of the keys to an empty table, and print the
+percentiles of the latencies in nanoseconds.
+
+@param name  The name of the table
+@param table The empty table
+@param keys  The keys to be inserted
+*/
+template<typename Table>
+void runLatency(const string &name, Table &table, const vector<Key> &keys) {
+    typedef std::chrono::steady_clock Clock;
+    vector<long long> lat;
+    lat.reserve(keys.size());
+    for (const auto &k : keys) {
+        auto start = Clock::now();
+        insertKey(table, k);
+        lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    auto percentile = [&](const double p) {
+        auto it = lat.begin() + (std::size_t)(p * (lat.size() - 1));
+        std::nth_element(lat.begin(), it, lat.end());
+        return toString(*it);
+    };
+    printLn(name + ": p50 " + percentile(0.5) + " ns, p99 " + percentile(0.99)
+            + " ns, p999 " + percentile(0.999) + " ns, max " + percentile(1.0) + " ns");
+}
+
+int main() {
+    printLn("Benchmark of HashTable running...\n");
+    {
+        const int SIZES[] = {1000000, 10000000};
+        for (int size : SIZES) {
+            // Distinct keys in random order
+            vector<Key> keys, misses;
+            keys.reserve(size);
+            misses.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                keys.push_back((Key)i * 0x9E3779B97F4A7C15ull);
+                misses.push_back((Key)(i + size) * 0x9E3779B97F4A7C15ull);
+            }
+            randChange(keys);
+            vector<Key> hits(keys);
+            randChange(hits);
+            printLn("Inserting, looking up and removing " + toString(size) + " integer keys...");
+            std::size_t found1, found2, found3;
+            {
+                HashTable<Key> table;
+                found1 = run("HashTable", table, keys, hits, misses);
+            }
+            {
+                FlatHashTable<Key> table;
+                found2 = run("FlatHashTable", table, keys, hits, misses);
+            }
+            {
+                std::unordered_set<Key> table;
+                found3 = run("std::unordered_set", table, keys, hits, misses);
+            }
+            bool pass = found1 == (std::size_t)size && found1 == found2 && found2 == found3;
+            printLn("Correctness check: " + string(pass ? "pass" : "fail") + "\n");
+        }
+    }
+    {
+        const int SIZE = 10000000;
+        vector<Key> keys;
+        keys.reserve(SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            keys.push_back((Key)i * 0x9E3779B97F4A7C15ull);
+        }
+        randChange(keys);
+        printLn("Latency of each insertion of " + toString(SIZE) + " integer keys to an empty table...");
+        {
+            HashTable<Key> table;
+            runLatency("HashTable", table, keys);
+        }
+        {
+            FlatHashTable<Key> table;
+            runLatency("FlatHashTable", table, keys);
+        }
+        {
+            std::unordered_set<Key> table;
+            runLatency("std::unordered_set", table, keys);
+        }
+        printLn("");
+    }
+    printLn("Benchmark of HashTable finished.");
+    checkMemoryLeaks();
+    return 0;
+}
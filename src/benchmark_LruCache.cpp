@@ -0,0 +1,124 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/LruCache.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+/*
+Generate a stream of keys in [0, n) whose frequencies follow Zipf's
+law, that is, the key of rank k is drawn with a probability
+proportional to 1 / k^s.
+
+@param n    The amount of distinct keys
+@param s    The exponent of the distribution
+@param size The length of the stream
+*/
+vector<int> zipfStream(const int n, const double s, const int size) {
+    vector<double> cdf(n);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += 1 / std::pow(i + 1, s);
+        cdf[i] = sum;
+    }
+    // Shuffle the ranks so hot keys do not cluster at small values
+    vector<int> keys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    randChange(keys);
+    vector<int> stream(size);
+    for (int i = 0; i < size; ++i) {
+        double r = tastylib::rand() * sum;
+        auto rank = std::lower_bound(cdf.begin(), cdf.end(), r) - cdf.begin();
+        stream[i] = keys[rank < n ? rank : n - 1];
+    }
+    return stream;
+}
+
+/*
+Run the benchmark workloads on a cache.
+
+@param name     The name of the cache
+@param cache    The cache, which is empty
+@param stream   The Zipfian key stream
+@param freshKey The first key that never appears in the stream
+*/
+template<typename Cache>
+void runCache(const string &name, Cache &cache, const vector<int> &stream, const int freshKey) {
+    const int size = (int)stream.size();
+    printLn("Benchmarking " + name + " with capacity " + toString(cache.getCapacity()) + "...");
+
+    // Look up each key and put it on a miss
+    int hits = 0;
+    auto time = timing([&]() {
+        for (const auto &key : stream) {
+            if (cache.get(key)) {
+                ++hits;
+            } else {
+                cache.put(key, key);
+            }
+        }
+    });
+    printLn("Hit ratio: " + toString(100.0 * hits / size) + "%");
+    printLn("Avg time of get() + put() on a miss: " + toString(time / size) + " ms");
+
+    // Look up keys that are known to be cached
+    vector<int> hitKeys;
+    for (const auto &key : stream) {
+        if (cache.has(key)) {
+            hitKeys.push_back(key);
+        }
+    }
+    long long sum = 0;
+    time = timing([&]() {
+        for (const auto &key : hitKeys) {
+            sum += *cache.get(key);
+        }
+    });
+    printLn("Avg time of get() on a hit: " + toString(time / hitKeys.size())
+            + " ms (checksum " + toString(sum) + ")");
+
+    // Put new keys into the full cache, each one evicting an item
+    time = timing([&]() {
+        for (int i = 0; i < size; ++i) {
+            cache.put(freshKey + i, i);
+        }
+    });
+    printLn("Avg time of put() with eviction: " + toString(time / size) + " ms");
+    printLn("Benchmark of " + name + " finished.\n");
+}
+
+int main() {
+    printLn("Benchmark of LruCache running...\n");
+    {
+        const int KEYS = 1000000;
+        const int SIZE = 10000000;
+        const int CAPACITY = 100000;
+        const double EXPONENTS[] = {0.8, 0.99, 1.2};
+        for (double s : EXPONENTS) {
+            printLn("Generating " + toString(SIZE) + " keys from " + toString(KEYS)
+                    + " distinct keys with Zipf exponent " + toString(s) + "...");
+            auto stream = zipfStream(KEYS, s, SIZE);
+            printLn("Finished.\n");
+            {
+                LruCache<int, int> cache(CAPACITY);
+                runCache("LruCache", cache, stream, KEYS);
+            }
+            {
+                LfuCache<int, int> cache(CAPACITY);
+                runCache("LfuCache", cache, stream, KEYS);
+            }
+        }
+    }
+    printLn("Benchmark of LruCache finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/MinMaxHeap.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef std::pair<int, int> Item;  // Key and id
+
+struct ItemGreaterEqual {
+    bool operator()(const Item &a, const Item &b) const {
+        return a.first >= b.first;
+    }
+};
+
+struct ItemLessEqual {
+    bool operator()(const Item &a, const Item &b) const {
+        return a.first <= b.first;
+    }
+};
+
+/*
+A double-ended priority queue made of a min-root heap and a max-root
+heap holding the same elements. An element removed from one heap is
+marked, and it is dropped from the other heap when it reaches the root.
+*/
+class TwoHeaps {
+public:
+    void push(const int key) {
+        minHeap.push(Item(key, (int)removed.size()));
+        maxHeap.push(Item(key, (int)removed.size()));
+        removed.push_back(false);
+        ++size;
+    }
+
+    int popMin() {
+        skipRemoved(minHeap);
+        Item item = minHeap.popTop();
+        removed[item.second] = true;
+        --size;
+        return item.first;
+    }
+
+    int popMax() {
+        skipRemoved(maxHeap);
+        Item item = maxHeap.popTop();
+        removed[item.second] = true;
+        --size;
+        return item.first;
+    }
+
+    std::size_t getSize() const {
+        return size;
+    }
+
+private:
+    BinaryHeap<Item, ItemGreaterEqual> minHeap;
+    BinaryHeap<Item, ItemLessEqual> maxHeap;
+    vector<bool> removed;
+    std::size_t size = 0;
+
+    template<typename Heap>
+    void skipRemoved(Heap &heap) {
+        while (removed[heap.top().second]) {
+            heap.pop();
+        }
+    }
+};
+
+/*
+Run a bounded buffer workload: push a key in each step, evict the
+largest key when the buffer is over capacity, and serve the smallest
+key in the steps given by 'serves'.
+
+@return The sum of the served keys.
+*/
+template<typename Queue, typename PopMin, typename PopMax>
+long long runBuffer(Queue &queue, const PopMin &popMin, const PopMax &popMax,
+                    const vector<int> &keys, const vector<bool> &serves,
+                    const std::size_t capacity) {
+    long long sum = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        queue.push(keys[i]);
+        if (queue.getSize() > capacity) {
+            popMax(queue);
+        }
+        if (serves[i]) {
+            sum += popMin(queue);
+        }
+    }
+    return sum;
+}
+
+int main() {
+    printLn("Benchmark of MinMaxHeap running...\n");
+    {
+        const int STEPS = 20000000;
+        const std::size_t CAPACITIES[] = {100, 10000, 1000000};
+        vector<int> keys;
+        vector<bool> serves;
+        for (int i = 0; i < STEPS; ++i) {
+            keys.push_back(randInt(0, 1 << 30));
+            serves.push_back(randInt(0, 2) == 0);  // Fewer serves than pushes
+        }
+        for (std::size_t capacity : CAPACITIES) {
+            printLn("Running a bounded buffer of capacity " + toString(capacity)
+                    + " for " + toString(STEPS) + " steps...");
+            long long twoSum = 0, minMaxSum = 0;
+            auto twoTime = timing([&]() {
+                TwoHeaps queue;
+                twoSum = runBuffer(queue, [](TwoHeaps &q) {
+                    return q.popMin();
+                }, [](TwoHeaps &q) {
+                    return q.popMax();
+                }, keys, serves, capacity);
+            });
+            auto minMaxTime = timing([&]() {
+                MinMaxHeap<int> queue;
+                minMaxSum = runBuffer(queue, [](MinMaxHeap<int> &q) {
+                    return q.popMinTop();
+                }, [](MinMaxHeap<int> &q) {
+                    return q.popMaxTop();
+                }, keys, serves, capacity);
+            });
+            printLn("Total time of two BinaryHeaps VS MinMaxHeap: " + toString(twoTime)
+                    + " ms / " + toString(minMaxTime) + " ms");
+            printLn("Correctness check: " + string(twoSum == minMaxSum ? "pass" : "fail") + "\n");
+        }
+    }
+    printLn("Benchmark of MinMaxHeap finished.");
+    checkMemoryLeaks();
+    return 0;
+}
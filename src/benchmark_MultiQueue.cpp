@@ -0,0 +1,246 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/MultiQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+/*
+A priority queue made of a BinaryHeap guarded by a mutex.
+*/
+class LockedHeap {
+public:
+    void push(const long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        heap.push(val);
+    }
+
+    bool tryPop(long long &val) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (heap.isEmpty()) {
+            return false;
+        }
+        val = heap.popTop();
+        return true;
+    }
+
+private:
+    std::mutex mtx;
+    BinaryHeap<long long> heap;
+};
+
+/*
+A xorshift generator owned by one thread.
+*/
+struct XorShift {
+    std::uint64_t state;
+
+    explicit XorShift(const std::uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+    int next(const int n) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return (int)((state >> 33) % n);
+    }
+};
+
+/*
+An operation recorded for measuring the rank error.
+*/
+struct Record {
+    long long seq;  // Order of the operation among all threads
+    long long key;
+    bool isPop;
+};
+
+/*
+Run a scheduler-like workload: each thread repeatedly pops an element
+and pushes a new element whose key is a bit larger than the popped one.
+
+@param queue   The queue, which is filled with the initial elements
+@param threads The amount of threads
+@param ops     The amount of pop-push pairs of each thread
+@param records Output. The operations of each thread if it is not nullptr.
+               Each operation and its record are then done under a global
+               lock, so the records are in the exact order of the operations.
+@return        The sum of the popped keys.
+*/
+template<typename Queue>
+long long runQueue(Queue &queue, const int threads, const int ops, vector<vector<Record>> *records) {
+    std::atomic<long long> sum(0);
+    long long seq = 0;
+    std::mutex recordMtx;
+    vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            XorShift rng(t + 1);
+            long long key, localSum = 0;
+            for (int i = 0; i < ops; ++i) {
+                long long newKey;
+                if (records) {
+                    std::lock_guard<std::mutex> lock(recordMtx);
+                    if (!queue.tryPop(key)) {
+                        continue;
+                    }
+                    newKey = key + 1 + rng.next(1000);
+                    (*records)[t].push_back(Record{seq++, key, true});
+                    queue.push(newKey);
+                    (*records)[t].push_back(Record{seq++, newKey, false});
+                } else {
+                    if (!queue.tryPop(key)) {
+                        continue;
+                    }
+                    newKey = key + 1 + rng.next(1000);
+                    queue.push(newKey);
+                }
+                localSum += key;
+            }
+            sum += localSum;
+        });
+    }
+    for (auto &th : pool) {
+        th.join();
+    }
+    return sum;
+}
+
+/*
+Replay the recorded operations in their global order and print
+the histogram of the rank errors of the pops. The rank error of
+a pop is the amount of smaller keys in the queue at that time.
+
+@param initKeys The initial keys in the queue
+@param records  The operations of each thread
+*/
+void printRankErrors(const vector<long long> &initKeys, const vector<vector<Record>> &records) {
+    vector<Record> all;
+    for (const auto &r : records) {
+        all.insert(all.end(), r.begin(), r.end());
+    }
+    std::sort(all.begin(), all.end(), [](const Record &a, const Record &b) {
+        return a.seq < b.seq;
+    });
+    // Count the keys in the queue with a Fenwick tree over the sorted distinct keys
+    vector<long long> keys(initKeys);
+    for (const auto &r : all) {
+        keys.push_back(r.key);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    vector<long long> tree(keys.size() + 1, 0);
+    auto add = [&](const long long key, const int delta) {
+        std::size_t i = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin() + 1;
+        for (; i < tree.size(); i += i & (~i + 1)) {
+            tree[i] += delta;
+        }
+    };
+    auto countLess = [&](const long long key) {
+        long long cnt = 0;
+        std::size_t i = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+        for (; i > 0; i -= i & (~i + 1)) {
+            cnt += tree[i];
+        }
+        return cnt;
+    };
+    for (const auto &key : initKeys) {
+        add(key, 1);
+    }
+    const long long BOUNDS[] = {1, 4, 16, 64, 256, 1024};
+    const int BUCKETS = 7;
+    long long hist[BUCKETS] = {}, pops = 0, rankSum = 0;
+    for (const auto &r : all) {
+        if (!r.isPop) {
+            add(r.key, 1);
+            continue;
+        }
+        add(r.key, -1);
+        long long rank = countLess(r.key);
+        int b = 0;
+        while (b < BUCKETS - 1 && rank >= BOUNDS[b]) {
+            ++b;
+        }
+        ++hist[b];
+        ++pops;
+        rankSum += rank;
+    }
+    const char *NAMES[] = {"0", "1-3", "4-15", "16-63", "64-255", "256-1023", ">=1024"};
+    string line = "Rank error histogram:";
+    for (int b = 0; b < BUCKETS; ++b) {
+        line += string(" [") + NAMES[b] + "] " + toString(100.0 * hist[b] / (pops ? pops : 1)) + "%";
+    }
+    printLn(line);
+    printLn("Mean rank error: " + toString((double)rankSum / (pops ? pops : 1)));
+}
+
+int main() {
+    printLn("Benchmark of MultiQueue running...\n");
+    {
+        const int INIT_SIZE = 1000000;
+        const int TOTAL_OPS = 4000000;
+        const int THREADS[] = {1, 2, 4, 8, 16, 32, 64};
+        vector<long long> initKeys;
+        for (int i = 0; i < INIT_SIZE; ++i) {
+            initKeys.push_back(randInt(0, INIT_SIZE));
+        }
+        printLn("Hardware concurrency: " + toString(std::thread::hardware_concurrency()));
+        printLn("Each pop is followed by a push of a larger key. Initial elements: "
+                + toString(INIT_SIZE) + ", pop-push pairs: " + toString(TOTAL_OPS) + "\n");
+        for (int threads : THREADS) {
+            const int ops = TOTAL_OPS / threads;
+            printLn("Threads: " + toString(threads));
+            long long lockSum = 0, multiSum = 0;
+            double lockTime, multiTime;
+            {
+                LockedHeap queue;
+                for (const auto &key : initKeys) {
+                    queue.push(key);
+                }
+                lockTime = wallTiming([&]() {
+                    lockSum = runQueue(queue, threads, ops, nullptr);
+                });
+            }
+            {
+                MultiQueue<long long> queue(threads);
+                for (const auto &key : initKeys) {
+                    queue.push(key);
+                }
+                multiTime = wallTiming([&]() {
+                    multiSum = runQueue(queue, threads, ops, nullptr);
+                });
+            }
+            const double pairs = (double)ops * threads;
+            printLn("Throughput of mutex + BinaryHeap VS MultiQueue: "
+                    + toString(pairs / lockTime / 1000) + " M pairs/s / "
+                    + toString(pairs / multiTime / 1000) + " M pairs/s (checksum "
+                    + toString(lockSum) + " / " + toString(multiSum) + ")");
+            {   // Measure the rank errors in a separate run with recording
+                MultiQueue<long long> queue(threads);
+                for (const auto &key : initKeys) {
+                    queue.push(key);
+                }
+                vector<vector<Record>> records(threads);
+                for (auto &r : records) {
+                    r.reserve(2 * ops);
+                }
+                runQueue(queue, threads, ops, &records);
+                printRankErrors(initKeys, records);
+            }
+            printLn("");
+        }
+    }
+    printLn("Benchmark of MultiQueue finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/AddressableHeap.h"
+#include "tastylib/PairingHeap.h"
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+/*
+A tentative distance of a vertex.
+*/
+struct Item {
+    long long dist;
+    int v;
+};
+
+struct ItemGreaterEqual {
+    bool operator()(const Item &a, const Item &b) const {
+        return a.dist >= b.dist;
+    }
+};
+
+/*
+A directed graph in compressed sparse row form.
+*/
+struct CsrGraph {
+    vector<int> first;  // Edges of vertex v are in [first[v], first[v + 1])
+    vector<int> to;
+    vector<int> weight;
+};
+
+/*
+Generate a random directed graph.
+
+@param vertexNum The amount of vertices
+@param degree    The amount of out edges of each vertex
+@param maxWeight The maximum weight of an edge
+*/
+CsrGraph randomGraph(const int vertexNum, const int degree, const int maxWeight) {
+    CsrGraph g;
+    g.first.resize(vertexNum + 1);
+    for (int v = 0; v <= vertexNum; ++v) {
+        g.first[v] = v * degree;
+    }
+    for (int i = 0; i < vertexNum * degree; ++i) {
+        g.to.push_back(randInt(0, vertexNum - 1));
+        g.weight.push_back(randInt(1, maxWeight));
+    }
+    return g;
+}
+
+const long long INF = std::numeric_limits<long long>::max();
+
+/*
+The statistics of a run of Dijkstra's algorithm.
+*/
+struct Stat {
+    long long decreases = 0;  // Amount of improved tentative distances
+    std::size_t maxSize = 0;  // Maximum size of the heap
+};
+
+/*
+Dijkstra's algorithm with a BinaryHeap. An improved vertex is pushed
+again, and the stale entries are skipped when they are popped.
+*/
+Stat dijkstraBinary(const CsrGraph &g, vector<long long> &dist) {
+    Stat stat;
+    BinaryHeap<Item, ItemGreaterEqual> heap;
+    dist.assign(g.first.size() - 1, INF);
+    dist[0] = 0;
+    heap.push(Item{0, 0});
+    while (!heap.isEmpty()) {
+        stat.maxSize = std::max(stat.maxSize, (std::size_t)heap.getSize());
+        Item cur = heap.popTop();
+        if (cur.dist != dist[cur.v]) {
+            continue;
+        }
+        for (int e = g.first[cur.v]; e < g.first[cur.v + 1]; ++e) {
+            long long d = cur.dist + g.weight[e];
+            int u = g.to[e];
+            if (d < dist[u]) {
+                stat.decreases += (dist[u] != INF);
+                dist[u] = d;
+                heap.push(Item{d, u});
+            }
+        }
+    }
+    return stat;
+}
+
+/*
+Dijkstra's algorithm with a heap that supports decreaseKey().
+*/
+template<typename Heap>
+Stat dijkstraDecrease(const CsrGraph &g, vector<long long> &dist) {
+    typedef typename Heap::Handle Handle;
+    Stat stat;
+    Heap heap;
+    vector<Handle> handles(g.first.size() - 1);
+    dist.assign(g.first.size() - 1, INF);
+    dist[0] = 0;
+    handles[0] = heap.push(Item{0, 0});
+    while (!heap.isEmpty()) {
+        stat.maxSize = std::max(stat.maxSize, (std::size_t)heap.getSize());
+        Item cur = heap.top();
+        heap.pop();
+        for (int e = g.first[cur.v]; e < g.first[cur.v + 1]; ++e) {
+            long long d = cur.dist + g.weight[e];
+            int u = g.to[e];
+            if (d < dist[u]) {
+                if (dist[u] == INF) {
+                    handles[u] = heap.push(Item{d, u});
+                } else {
+                    ++stat.decreases;
+                    heap.decreaseKey(handles[u], Item{d, u});
+                }
+                dist[u] = d;
+            }
+        }
+    }
+    return stat;
+}
+
+/*
+Print the result of a run of Dijkstra's algorithm.
+*/
+void printStat(const string &name, const double time, const Stat &stat, const vector<long long> &dist) {
+    long long sum = 0;
+    for (const auto &d : dist) {
+        if (d != INF) {
+            sum += d;
+        }
+    }
+    printLn(name + ": " + toString(time) + " ms, max heap size " + toString(stat.maxSize)
+            + ", decreases " + toString(stat.decreases) + " (checksum " + toString(sum) + ")");
+}
+
+int main() {
+    printLn("Benchmark of PairingHeap running...\n");
+    {   // Benchmark Dijkstra-like workloads
+        const int VERTEX_NUM = 1000000;
+        const int DEGREES[] = {4, 16, 64};
+        const int MAX_WEIGHT = 1000;
+        for (int degree : DEGREES) {
+            printLn("Generating a graph of " + toString(VERTEX_NUM) + " vertices and "
+                    + toString((long long)VERTEX_NUM * degree) + " edges...");
+            CsrGraph g = randomGraph(VERTEX_NUM, degree, MAX_WEIGHT);
+            printLn("Finished.");
+            vector<long long> dist;
+            Stat stat;
+            auto time = timing([&]() {
+                stat = dijkstraBinary(g, dist);
+            });
+            printStat("BinaryHeap (lazy deletion)", time, stat, dist);
+            time = timing([&]() {
+                stat = dijkstraDecrease<AddressableHeap<Item, ItemGreaterEqual>>(g, dist);
+            });
+            printStat("AddressableHeap", time, stat, dist);
+            time = timing([&]() {
+                stat = dijkstraDecrease<PairingHeap<Item, ItemGreaterEqual>>(g, dist);
+            });
+            printStat("PairingHeap", time, stat, dist);
+            printLn("");
+        }
+    }
+    {   // Benchmark merging heaps
+        const int SIZE = 8000000;
+        const int HEAP_NUM = 8;
+        printLn("Merging " + toString(HEAP_NUM) + " heaps of " + toString(SIZE / HEAP_NUM)
+                + " elements into one...");
+        vector<int> vals;
+        for (int i = 0; i < SIZE; ++i) {
+            vals.push_back(randInt(0, SIZE));
+        }
+        vector<BinaryHeap<int>> binaryHeaps(HEAP_NUM);
+        vector<PairingHeap<int>> pairingHeaps(HEAP_NUM);
+        for (int i = 0; i < SIZE; ++i) {
+            binaryHeaps[i % HEAP_NUM].push(vals[i]);
+            pairingHeaps[i % HEAP_NUM].push(vals[i]);
+        }
+        auto binaryTime = timing([&]() {
+            for (int i = 1; i < HEAP_NUM; ++i) {
+                while (!binaryHeaps[i].isEmpty()) {
+                    binaryHeaps[0].push(binaryHeaps[i].popTop());
+                }
+            }
+        });
+        auto pairingTime = timing([&]() {
+            for (int i = 1; i < HEAP_NUM; ++i) {
+                pairingHeaps[0].meld(pairingHeaps[i]);
+            }
+        });
+        printLn("Total time of BinaryHeap (pop and push) VS PairingHeap (meld): "
+                + toString(binaryTime) + " ms / " + toString(pairingTime) + " ms");
+        vector<int> binaryOut, pairingOut;
+        binaryOut.reserve(SIZE);
+        pairingOut.reserve(SIZE);
+        binaryTime = timing([&]() {
+            while (!binaryHeaps[0].isEmpty()) {
+                binaryOut.push_back(binaryHeaps[0].popTop());
+            }
+        });
+        pairingTime = timing([&]() {
+            while (!pairingHeaps[0].isEmpty()) {
+                pairingOut.push_back(pairingHeaps[0].popTop());
+            }
+        });
+        printLn("Avg time of pop() on the merged heaps of BinaryHeap VS PairingHeap: "
+                + toString(binaryTime / SIZE) + " ms / " + toString(pairingTime / SIZE) + " ms");
+        printLn("Correctness check: " + string(binaryOut == pairingOut ? "pass" : "fail"));
+        printLn("Benchmark of merging heaps finished.\n");
+    }
+    printLn("Benchmark of PairingHeap finished.");
+    checkMemoryLeaks();
+    return 0;
+}
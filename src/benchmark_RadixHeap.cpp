@@ -0,0 +1,102 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/RadixHeap.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef std::int32_t Key;  // The same as Graph::WeightType
+typedef std::pair<Key, int> Item;
+
+struct ItemGreaterEqual {
+    bool operator()(const Item &a, const Item &b) const {
+        return a.first >= b.first;
+    }
+};
+
+/*
+Run a Dijkstra-like stream on a heap: pop the element with the smallest
+key, and push a given amount of elements whose keys are the popped key
+plus an edge weight. The stream ends after a given amount of operations
+or when the heap becomes empty.
+
+@param heap    The heap, which is filled with the initial elements
+@param fanouts The amount of pushes after each pop
+@param weights The edge weights
+@param ops     The amount of operations
+@return        The sum of the popped keys.
+*/
+template<typename Heap, typename PushFunc>
+long long runStream(Heap &heap, const PushFunc &push, const vector<int> &fanouts,
+                    const vector<Key> &weights, const int ops) {
+    long long sum = 0;
+    std::size_t w = 0, f = 0;
+    for (int i = 0; i < ops && !heap.isEmpty();) {
+        Item item = heap.popTop();
+        sum += item.first;
+        ++i;
+        for (int j = 0; j < fanouts[f]; ++j, ++i) {
+            push(heap, Item(item.first + weights[w], item.second + j));
+            w = (w + 1 == weights.size() ? 0 : w + 1);
+        }
+        f = (f + 1 == fanouts.size() ? 0 : f + 1);
+    }
+    return sum;
+}
+
+int main() {
+    printLn("Benchmark of RadixHeap running...\n");
+    {
+        const int OPS = 10000000;
+        const int INIT_SIZES[] = {1000, 1000000};
+        const Key MAX_WEIGHTS[] = {100, 10000};
+        vector<int> fanouts;
+        for (int i = 0; i < 1 << 20; ++i) {
+            fanouts.push_back(randInt(0, 2));  // One push per pop on average
+        }
+        for (int initSize : INIT_SIZES) {
+            for (Key maxWeight : MAX_WEIGHTS) {
+                printLn("Running " + toString(OPS) + " operations on " + toString(initSize)
+                        + " initial elements with edge weights in [0, " + toString(maxWeight) + "]...");
+                vector<Key> weights;
+                for (int i = 0; i < 1 << 20; ++i) {
+                    weights.push_back(randInt(0, maxWeight));
+                }
+                vector<Item> init;
+                for (int i = 0; i < initSize; ++i) {
+                    init.push_back(Item(randInt(0, maxWeight), i));
+                }
+                long long binarySum = 0, radixSum = 0;
+                auto binaryTime = timing([&]() {
+                    BinaryHeap<Item, ItemGreaterEqual> heap(init.begin(), init.end());
+                    binarySum = runStream(heap, [](BinaryHeap<Item, ItemGreaterEqual> &h, const Item &item) {
+                        h.push(item);
+                    }, fanouts, weights, OPS);
+                });
+                auto radixTime = timing([&]() {
+                    RadixHeap<Key, int> heap;
+                    for (const auto &item : init) {
+                        heap.push(item.first, item.second);
+                    }
+                    radixSum = runStream(heap, [](RadixHeap<Key, int> &h, const Item &item) {
+                        h.push(item.first, item.second);
+                    }, fanouts, weights, OPS);
+                });
+                printLn("Total time of BinaryHeap VS RadixHeap: " + toString(binaryTime) + " ms / "
+                        + toString(radixTime) + " ms");
+                printLn("Correctness check: " + string(binarySum == radixSum ? "pass" : "fail") + "\n");
+            }
+        }
+    }
+    printLn("Benchmark of RadixHeap finished.");
+    checkMemoryLeaks();
+    return 0;
+}
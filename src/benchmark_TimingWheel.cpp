@@ -0,0 +1,111 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/TimingWheel.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef std::uint64_t Time;
+typedef std::pair<Time, int> Timer;  // Expiration time and id
+
+struct TimerGreaterEqual {
+    bool operator()(const Timer &a, const Timer &b) const {
+        return a.first >= b.first;
+    }
+};
+
+/*
+Return the rate of operations in million operations per second.
+*/
+string rate(const std::size_t ops, const double ms) {
+    return toString(ops / ms / 1000) + " M/s";
+}
+
+int main() {
+    printLn("Benchmark of TimingWheel running...\n");
+    {
+        const int SIZES[] = {1000000, 10000000, 30000000};
+        const Time MAX_DELAY = 1 << 20;
+        const Time STEP = 1000;
+        for (int size : SIZES) {
+            printLn("Scheduling " + toString(size) + " timers with delays in [1, "
+                    + toString(MAX_DELAY) + "] ticks, cancelling 90% of them, and firing the rest...");
+            vector<Time> delays;
+            vector<int> cancels;
+            delays.reserve(size);
+            cancels.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                delays.push_back(randInt<Time>(1, MAX_DELAY));
+                cancels.push_back(i);
+            }
+            randChange(cancels);
+            cancels.resize(size / 10 * 9);
+            long long heapSum = 0, wheelSum = 0;
+            double heapTimes[3], wheelTimes[3];
+            {   // BinaryHeap with lazy cancellation
+                BinaryHeap<Timer, TimerGreaterEqual> heap;
+                vector<bool> cancelled(size, false);
+                heapTimes[0] = timing([&]() {
+                    for (int i = 0; i < size; ++i) {
+                        heap.push(Timer(delays[i], i));
+                    }
+                });
+                heapTimes[1] = timing([&]() {
+                    for (const auto &id : cancels) {
+                        cancelled[id] = true;
+                    }
+                });
+                heapTimes[2] = timing([&]() {
+                    for (Time now = 0; now <= MAX_DELAY; now += STEP) {
+                        while (!heap.isEmpty() && heap.top().first <= now) {
+                            int id = heap.popTop().second;
+                            if (!cancelled[id]) {
+                                heapSum += id;
+                            }
+                        }
+                    }
+                });
+            }
+            {
+                TimingWheel<int> wheel;
+                vector<TimingWheel<int>::Handle> handles(size);
+                wheelTimes[0] = timing([&]() {
+                    for (int i = 0; i < size; ++i) {
+                        handles[i] = wheel.schedule(delays[i], i);
+                    }
+                });
+                wheelTimes[1] = timing([&]() {
+                    for (const auto &id : cancels) {
+                        wheel.cancel(handles[id]);
+                    }
+                });
+                wheelTimes[2] = timing([&]() {
+                    for (Time now = 0; now <= MAX_DELAY; now += STEP) {
+                        wheel.advance(now, [&](const int id) {
+                            wheelSum += id;
+                        });
+                    }
+                });
+            }
+            const std::size_t fired = size - cancels.size();
+            printLn("Schedule rate of BinaryHeap VS TimingWheel: " + rate(size, heapTimes[0])
+                    + " / " + rate(size, wheelTimes[0]));
+            printLn("Cancel rate of BinaryHeap (lazy) VS TimingWheel: " + rate(cancels.size(), heapTimes[1])
+                    + " / " + rate(cancels.size(), wheelTimes[1]));
+            printLn("Fire rate of BinaryHeap VS TimingWheel: " + rate(fired, heapTimes[2])
+                    + " / " + rate(fired, wheelTimes[2]));
+            printLn("Correctness check: " + string(heapSum == wheelSum ? "pass" : "fail") + "\n");
+        }
+    }
+    printLn("Benchmark of TimingWheel finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "tastylib/util/io.h"
+#include "tastylib/util/timer.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/BinaryHeap.h"
+#include "tastylib/TopK.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+int main() {
+    printLn("Benchmark of TopK running...\n");
+    {
+        const int STREAM_SIZE = 50000000;
+        const int CAPACITIES[] = {10, 1000, 100000};
+        vector<int> stream;
+        stream.reserve(STREAM_SIZE);
+        for (int i = 0; i < STREAM_SIZE; ++i) {
+            stream.push_back(randInt(0, RAND_MAX));
+        }
+        printLn("Selecting the largest K values of a stream of " + toString(STREAM_SIZE)
+                + " random integers...");
+        for (int k : CAPACITIES) {
+            printLn("K: " + toString(k));
+            long long heapSum = 0, singleSum = 0, batchSum = 0, nthSum = 0;
+            auto heapTime = timing([&]() {
+                BinaryHeap<int> heap;
+                for (const auto &x : stream) {
+                    heap.push(x);
+                    if (heap.getSize() > (std::size_t)k) {
+                        heap.pop();
+                    }
+                }
+                while (!heap.isEmpty()) {
+                    heapSum += heap.popTop();
+                }
+            });
+            auto singleTime = timing([&]() {
+                TopK<int> topK(k);
+                for (const auto &x : stream) {
+                    topK.offer(x);
+                }
+                for (const auto &x : topK.extractSorted()) {
+                    singleSum += x;
+                }
+            });
+            auto batchTime = timing([&]() {
+                TopK<int> topK(k);
+                topK.offer(stream.begin(), stream.end());
+                for (const auto &x : topK.extractSorted()) {
+                    batchSum += x;
+                }
+            });
+            auto nthTime = timing([&]() {
+                vector<int> copy(stream);
+                std::nth_element(copy.begin(), copy.begin() + k, copy.end(), std::greater<int>());
+                for (int i = 0; i < k; ++i) {
+                    nthSum += copy[i];
+                }
+            });
+            printLn("Total time of push + pop VS offer() VS offer(range) VS std::nth_element: "
+                    + toString(heapTime) + " ms / " + toString(singleTime) + " ms / "
+                    + toString(batchTime) + " ms / " + toString(nthTime) + " ms");
+            bool pass = heapSum == singleSum && singleSum == batchSum && batchSum == nthSum;
+            printLn("Correctness check: " + string(pass ? "pass" : "fail") + "\n");
+        }
+    }
+    printLn("Benchmark of TopK finished.");
+    checkMemoryLeaks();
+    return 0;
+}
@@ -3,12 +3,32 @@
 #include "tastylib/util/random.h"
 #include "tastylib/util/convert.h"
 #include "tastylib/util/swap.h"
+#include "tastylib/util/string_ref.h"
 #include "tastylib/DoublyLinkedList.h"
+#include "tastylib/ArrayLinkedList.h"
+#include "tastylib/UnrolledLinkedList.h"
+#include "tastylib/IndexableSkipList.h"
+#include "tastylib/ChunkedDeque.h"
+#include "tastylib/ConcurrentQueue.h"
+#include "tastylib/IntrusiveList.h"
 #include "tastylib/BinaryHeap.h"
+#include "tastylib/AddressableHeap.h"
+#include "tastylib/PairingHeap.h"
+#include "tastylib/MultiQueue.h"
+#include "tastylib/RadixHeap.h"
+#include "tastylib/TopK.h"
+#include "tastylib/MinMaxHeap.h"
+#include "tastylib/ExternalPriorityQueue.h"
+#include "tastylib/TimingWheel.h"
 #include "tastylib/HashTable.h"
+#include "tastylib/FlatHashTable.h"
+#include "tastylib/HashMap.h"
+#include "tastylib/ConcurrentHashTable.h"
+#include "tastylib/LruCache.h"
 #include "tastylib/AVLTree.h"
 #include "tastylib/Graph.h"
 #include "tastylib/MD5.h"
+#include "tastylib/Hash.h"
 #include "tastylib/NPuzzle.h"
 #include "tastylib/Sort.h"
 #include "tastylib/Dijkstra.h"
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/AddressableHeap.h"
+#include <map>
+
+using namespace tastylib;
+using std::vector;
+
+typedef AddressableHeap<int>::SizeType SizeType;
+typedef AddressableHeap<int>::Handle Handle;
+
+TEST(AddressableHeap, Basic) {
+    AddressableHeap<int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)0);
+    Handle h50 = heap.push(50);
+    Handle h20 = heap.push(20);
+    Handle h30 = heap.push(30);
+    EXPECT_FALSE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)3);
+    EXPECT_TRUE(heap.contains(h50));
+    EXPECT_TRUE(heap.contains(h20));
+    EXPECT_TRUE(heap.contains(h30));
+    EXPECT_EQ(heap.get(h30), 30);
+    EXPECT_EQ(heap.top(), 20);
+    EXPECT_EQ(heap.topHandle(), h20);
+    heap.pop();
+    EXPECT_FALSE(heap.contains(h20));
+    EXPECT_EQ(heap.top(), 30);
+    heap.pop();
+    EXPECT_EQ(heap.top(), 50);
+    EXPECT_EQ(heap.getSize(), (SizeType)1);
+    heap.pop();
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_FALSE(heap.contains(h50));
+    EXPECT_FALSE(heap.contains(1000));
+    heap.push(10);
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(AddressableHeap, ChangeKey) {
+    AddressableHeap<int> heap;
+    Handle h10 = heap.push(10);
+    Handle h20 = heap.push(20);
+    Handle h30 = heap.push(30);
+    EXPECT_TRUE(heap.decreaseKey(h30, 5));
+    EXPECT_EQ(heap.top(), 5);
+    EXPECT_EQ(heap.topHandle(), h30);
+    EXPECT_FALSE(heap.decreaseKey(h20, 25));  // Not a decrease
+    EXPECT_EQ(heap.get(h20), 20);
+    EXPECT_TRUE(heap.increaseKey(h30, 40));
+    EXPECT_EQ(heap.topHandle(), h10);
+    EXPECT_FALSE(heap.increaseKey(h10, 1));  // Not an increase
+    EXPECT_TRUE(heap.update(h20, 1));
+    EXPECT_EQ(heap.topHandle(), h20);
+    EXPECT_TRUE(heap.update(h20, 100));
+    EXPECT_EQ(heap.topHandle(), h10);
+    EXPECT_TRUE(heap.erase(h10));
+    EXPECT_FALSE(heap.erase(h10));
+    EXPECT_FALSE(heap.update(h10, 0));
+    EXPECT_EQ(heap.top(), 40);
+    heap.pop();
+    EXPECT_EQ(heap.top(), 100);
+    EXPECT_EQ(heap.getSize(), (SizeType)1);
+}
+
+TEST(AddressableHeap, Reuse) {
+    AddressableHeap<int> heap;
+    Handle h1 = heap.push(1);
+    heap.push(2);
+    heap.erase(h1);
+    Handle h3 = heap.push(3);
+    EXPECT_EQ(h3, h1);  // The handle of an erased element is reused
+    EXPECT_EQ(heap.get(h3), 3);
+    EXPECT_EQ(heap.top(), 2);
+}
+
+TEST(AddressableHeap, MaxRoot) {
+    AddressableHeap<int, std::less_equal<int>> heap;
+    vector<int> add;
+    for (int i = 0; i < 30; ++i) {
+        add.push_back(i);
+    }
+    randChange(add);
+    for (const auto &x : add) {
+        heap.push(x);
+    }
+    for (int i = 29; i >= 0; --i) {
+        EXPECT_EQ(heap.top(), i);
+        heap.pop();
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(AddressableHeap, Random) {
+    AddressableHeap<int> heap;
+    std::multimap<int, Handle> ans;  // Value -> handle
+    vector<Handle> live;
+    auto removeAns = [&](const Handle h, const int val) {
+        auto range = ans.equal_range(val);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == h) {
+                ans.erase(it);
+                return;
+            }
+        }
+        FAIL();
+    };
+    auto removeLive = [&](const Handle h) {
+        for (auto &x : live) {
+            if (x == h) {
+                x = live.back();
+                live.pop_back();
+                return;
+            }
+        }
+        FAIL();
+    };
+    for (int i = 0; i < 20000; ++i) {
+        int op = randInt(0, 5);
+        if (op <= 1 || live.empty()) {
+            int val = randInt(0, 1000);
+            Handle h = heap.push(val);
+            ans.insert(std::make_pair(val, h));
+            live.push_back(h);
+        } else if (op == 2) {
+            EXPECT_EQ(heap.top(), ans.begin()->first);
+            Handle h = heap.topHandle();
+            removeAns(h, heap.top());
+            removeLive(h);
+            heap.pop();
+        } else if (op == 3) {
+            Handle h = live[randInt(0, (int)live.size() - 1)];
+            removeAns(h, heap.get(h));
+            removeLive(h);
+            EXPECT_TRUE(heap.erase(h));
+            EXPECT_FALSE(heap.contains(h));
+        } else {
+            Handle h = live[randInt(0, (int)live.size() - 1)];
+            int val = randInt(0, 1000), old = heap.get(h);
+            removeAns(h, old);
+            ans.insert(std::make_pair(val, h));
+            if (op == 4) {
+                EXPECT_EQ(heap.decreaseKey(h, val), val <= old);
+            } else {
+                EXPECT_EQ(heap.increaseKey(h, val), val >= old);
+            }
+            heap.update(h, val);
+            EXPECT_EQ(heap.get(h), val);
+        }
+        EXPECT_EQ(heap.getSize(), (SizeType)ans.size());
+    }
+    while (!heap.isEmpty()) {
+        EXPECT_EQ(heap.top(), ans.begin()->first);
+        ans.erase(ans.begin());
+        heap.pop();
+    }
+}
@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
+#include "tastylib/ArrayLinkedList.h"
+#include <cstdint>
+#include <string>
+#include <list>
+
+using tastylib::ArrayLinkedList;
+using tastylib::toString;
+using tastylib::randInt;
+using std::string;
+
+typedef ArrayLinkedList<int>::SizeType SizeType;
+
+template<typename T>
+string getListContent(const ArrayLinkedList<T> &list) {
+    string str;
+    list.traverse([&](const SizeType pos, const T &val) {
+        UNUSED(pos);
+        str += toString(val);
+    });
+    return str;
+}
+
+TEST(ArrayLinkedList, Basic) {
+    ArrayLinkedList<int> list;
+    EXPECT_TRUE(list.isEmpty());
+    list.insertBack(1);
+    EXPECT_STREQ(getListContent(list).c_str(), "1");
+    list.insertFront(2);
+    EXPECT_STREQ(getListContent(list).c_str(), "21");
+    list.insert(1, 3);
+    EXPECT_STREQ(getListContent(list).c_str(), "231");
+    list.insert(3, 4);
+    EXPECT_STREQ(getListContent(list).c_str(), "2314");
+    list.sort();
+    EXPECT_STREQ(getListContent(list).c_str(), "1234");
+    int p1 = list.find(3);
+    EXPECT_EQ(p1, 2);
+    list.remove(p1);
+    EXPECT_STREQ(getListContent(list).c_str(), "124");
+    list.removeFront();
+    EXPECT_STREQ(getListContent(list).c_str(), "24");
+    list.removeBack();
+    EXPECT_STREQ(getListContent(list).c_str(), "2");
+    int p2 = list.find(3);
+    EXPECT_EQ(p2, -1);
+    EXPECT_EQ(list.getSize(), (SizeType)1);
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.getSize(), (SizeType)0);
+}
+
+TEST(ArrayLinkedList, InsertRemove) {
+    ArrayLinkedList<int> list;
+    for (int i = 1; i < 10; ++i) {
+        list.insertBack(i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        list.insert(2 * i + 1, 0);
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "10203040506070809");
+    list.insert(0, 1);
+    list.insert(100, 9);
+    EXPECT_STREQ(getListContent(list).c_str(), "1102030405060708099");
+    list.clear();
+    for (int i = 1; i < 6; ++i) {
+        list.insertBack(i);
+    }
+    list.remove(0);
+    list.remove(3);
+    list.remove(100);
+    EXPECT_STREQ(getListContent(list).c_str(), "234");
+    list.remove(1);
+    list.remove(1);
+    EXPECT_STREQ(getListContent(list).c_str(), "2");
+    list.removeBack();
+    list.removeFront();
+    EXPECT_STREQ(getListContent(list).c_str(), "");
+}
+
+TEST(ArrayLinkedList, Iterator) {
+    ArrayLinkedList<int> list;
+    auto it = list.insert(list.end(), 3);
+    list.insert(list.begin(), 1);
+    it = list.insert(it, 2);
+    EXPECT_EQ(*it, 2);
+    EXPECT_STREQ(getListContent(list).c_str(), "123");
+    string str;
+    for (auto rit = list.end(); rit != list.begin();) {
+        str += toString(*--rit);
+    }
+    EXPECT_STREQ(str.c_str(), "321");
+    it = list.erase(it);
+    EXPECT_EQ(*it, 3);
+    it = list.findIf([](const int &x) { return x == 1; });
+    EXPECT_TRUE(it == list.begin());
+    list.erase(list.begin(), list.end());
+    EXPECT_TRUE(list.isEmpty());
+
+    // Insert by iterator while the array grows
+    for (int i = 0; i < 8; ++i) {
+        list.insertBack(2 * i);
+    }
+    it = list.findIf([](const int &x) { return x == 8; });
+    SizeType cap = list.getCapacity();
+    it = list.insert(it, 7);
+    EXPECT_GT(list.getCapacity(), cap);
+    EXPECT_EQ(*it, 7);
+    EXPECT_EQ(*++it, 8);
+    EXPECT_STREQ(getListContent(list).c_str(), "024678101214");
+}
+
+TEST(ArrayLinkedList, MaxSize) {
+    // Index 255 marks null nodes, so 255 nodes fit
+    typedef ArrayLinkedList<int, std::equal_to<int>, std::uint8_t> SmallList;
+    EXPECT_EQ(SmallList::getMaxSize(), (SizeType)255);
+    SmallList list;
+    for (int i = 0; i < 255; ++i) {
+        list.insertBack(i);
+    }
+    EXPECT_EQ(list.getCapacity(), (SizeType)255);
+    EXPECT_EQ(list.getSize(), (SizeType)255);
+    int expect = 0;
+    for (const auto &val : list) {
+        EXPECT_EQ(val, expect++);
+    }
+    EXPECT_EQ(expect, 255);
+    list.removeFront();
+    list.insert(list.begin(), -1);
+    EXPECT_EQ(list.getSize(), (SizeType)255);
+    EXPECT_EQ(*list.begin(), -1);
+    list.reserve(1000);
+    EXPECT_EQ(list.getCapacity(), (SizeType)255);
+}
+
+TEST(ArrayLinkedList, Sort) {
+    ArrayLinkedList<string> list;
+    list.sort();
+    EXPECT_TRUE(list.isEmpty());
+    const char *vals[] = {"d", "b", "e", "a", "c"};
+    for (const auto &v : vals) {
+        list.insertFront(v);
+    }
+    list.removeBack();
+    list.insertBack("f");
+    list.sort();
+    EXPECT_STREQ(getListContent(list).c_str(), "abcef");
+    list.sort(std::greater<string>());
+    EXPECT_STREQ(getListContent(list).c_str(), "fecba");
+    list.insertBack("d");
+    EXPECT_STREQ(getListContent(list).c_str(), "fecbad");
+    EXPECT_EQ(list.find("d"), 5);
+}
+
+TEST(ArrayLinkedList, Random) {
+    ArrayLinkedList<int> list;
+    std::list<int> ans;
+    for (int i = 0; i < 5000; ++i) {
+        int op = randInt(0, 5);
+        SizeType pos = randInt<SizeType>(0, ans.size());
+        if (op == 0) {
+            list.insertFront(i);
+            ans.push_front(i);
+        } else if (op == 1) {
+            list.insertBack(i);
+            ans.push_back(i);
+        } else if (op == 2) {
+            list.insert(pos, i);
+            auto it = ans.begin();
+            std::advance(it, pos);
+            ans.insert(it, i);
+        } else if (op == 3 && !ans.empty()) {
+            list.removeFront();
+            ans.pop_front();
+        } else if (op == 4 && !ans.empty()) {
+            list.removeBack();
+            ans.pop_back();
+        } else if (pos < ans.size()) {
+            list.remove(pos);
+            auto it = ans.begin();
+            std::advance(it, pos);
+            ans.erase(it);
+        }
+    }
+    ASSERT_EQ(list.getSize(), ans.size());
+    auto it = ans.begin();
+    for (const auto &x : list) {
+        EXPECT_EQ(x, *it++);
+    }
+}
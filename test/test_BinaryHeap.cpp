@@ -1,6 +1,11 @@
 #include "gtest/gtest.h"
 #include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
 #include "tastylib/BinaryHeap.h"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
 
 using namespace tastylib;
 using std::vector;
@@ -62,3 +67,147 @@ TEST(BinaryHeap, MaxRoot) {
     }
     EXPECT_TRUE(heap.isEmpty());
 }
+
+template<std::size_t Arity>
+void checkArity() {
+    BinaryHeap<int, std::greater_equal<int>, Arity> minHeap;
+    BinaryHeap<int, std::less_equal<int>, Arity> maxHeap;
+    vector<int> add;
+    for (int i = 0; i < 1000; ++i) {
+        add.push_back(randInt(0, 100));
+    }
+    for (const auto &x : add) {
+        minHeap.push(x);
+        maxHeap.push(x);
+    }
+    vector<int> ans(add);
+    std::sort(ans.begin(), ans.end());
+    for (SizeType i = 0; i < ans.size(); ++i) {
+        EXPECT_EQ(minHeap.top(), ans[i]);
+        EXPECT_EQ(maxHeap.top(), ans[ans.size() - 1 - i]);
+        minHeap.pop();
+        maxHeap.pop();
+    }
+    EXPECT_TRUE(minHeap.isEmpty());
+    EXPECT_TRUE(maxHeap.isEmpty());
+
+    // Interleave pushes and pops
+    for (int i = 0; i < 1000; ++i) {
+        minHeap.push(randInt(0, 100));
+        minHeap.push(randInt(0, 100));
+        int last = minHeap.top();
+        minHeap.pop();
+        EXPECT_LE(last, minHeap.top());
+    }
+    EXPECT_EQ(minHeap.getSize(), (SizeType)1000);
+}
+
+TEST(BinaryHeap, Arity) {
+    checkArity<2>();
+    checkArity<4>();
+    checkArity<8>();
+}
+
+TEST(BinaryHeap, Heapify) {
+    vector<int> vals;
+    for (int i = 0; i < 1000; ++i) {
+        vals.push_back(randInt(0, 100));
+    }
+    vector<int> ans(vals);
+    std::sort(ans.begin(), ans.end());
+
+    BinaryHeap<int> rangeHeap(vals.begin(), vals.end());
+    BinaryHeap<int, std::greater_equal<int>, 4> vecHeap(vals);
+    BinaryHeap<int, std::greater_equal<int>, 8> moveHeap{vector<int>(vals)};
+    EXPECT_EQ(rangeHeap.getSize(), (SizeType)1000);
+    for (const auto &x : ans) {
+        EXPECT_EQ(rangeHeap.popTop(), x);
+        EXPECT_EQ(vecHeap.popTop(), x);
+        EXPECT_EQ(moveHeap.popTop(), x);
+    }
+    EXPECT_TRUE(rangeHeap.isEmpty());
+
+    // A small range is pushed one by one, and a large one is heapified
+    BinaryHeap<int> heap(vals.begin(), vals.begin() + 500);
+    heap.pushRange(vals.begin() + 500, vals.begin() + 600);
+    heap.pushRange(vals.begin() + 600, vals.end());
+    heap.pushRange(vals.end(), vals.end());
+    EXPECT_EQ(heap.getSize(), (SizeType)1000);
+    for (const auto &x : ans) {
+        EXPECT_EQ(heap.top(), x);
+        heap.pop();
+    }
+
+    heap.pushRange(vals.begin(), vals.end());
+    EXPECT_EQ(heap.top(), ans[0]);
+    BinaryHeap<int> empty(vals.begin(), vals.begin());
+    EXPECT_TRUE(empty.isEmpty());
+}
+
+struct Task {
+    std::unique_ptr<int> priority;  // Move-only and not default constructible
+    std::string name;
+
+    Task(const int p, const std::string &name_) : priority(new int(p)), name(name_) {}
+};
+
+struct TaskGreaterEqual {
+    bool operator()(const Task &a, const Task &b) const {
+        return *a.priority >= *b.priority;
+    }
+};
+
+TEST(BinaryHeap, Move) {
+    BinaryHeap<std::string> strHeap;
+    std::string s(100, 'b');
+    strHeap.push(std::move(s));
+    strHeap.push(std::string(100, 'a'));
+    strHeap.emplace(100, 'c');
+    EXPECT_EQ(strHeap.top(), std::string(100, 'a'));
+    EXPECT_EQ(strHeap.popTop(), std::string(100, 'a'));
+    EXPECT_EQ(strHeap.popTop(), std::string(100, 'b'));
+    EXPECT_EQ(strHeap.popTop(), std::string(100, 'c'));
+    EXPECT_TRUE(strHeap.isEmpty());
+
+    BinaryHeap<Task, TaskGreaterEqual, 4> taskHeap;
+    for (int i = 0; i < 100; ++i) {
+        int p = randInt(0, 1000);
+        if (i % 2) {
+            taskHeap.emplace(p, toString(p));
+        } else {
+            taskHeap.push(Task(p, toString(p)));
+        }
+    }
+    int last = -1;
+    while (!taskHeap.isEmpty()) {
+        Task t = taskHeap.popTop();
+        EXPECT_LE(last, *t.priority);
+        EXPECT_EQ(t.name, toString(*t.priority));
+        last = *t.priority;
+    }
+}
+
+TEST(BinaryHeap, ReplaceTop) {
+    BinaryHeap<int, std::greater_equal<int>, 4> heap;
+    std::multiset<int> ans;
+    for (int i = 0; i < 100; ++i) {
+        int x = randInt(0, 1000);
+        heap.push(x);
+        ans.insert(x);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        int x = randInt(0, 1000);
+        heap.replaceTop(x);
+        ans.erase(ans.begin());
+        ans.insert(x);
+        EXPECT_EQ(heap.top(), *ans.begin());
+    }
+    EXPECT_EQ(heap.getSize(), (SizeType)100);
+    BinaryHeap<std::string> strHeap;
+    strHeap.push("a");
+    strHeap.push("c");
+    std::string s("d");
+    strHeap.replaceTop(std::move(s));
+    EXPECT_EQ(strHeap.popTop(), "c");
+    EXPECT_EQ(strHeap.popTop(), "d");
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
+#include "tastylib/ChunkedDeque.h"
+#include <string>
+#include <deque>
+
+using tastylib::ChunkedDeque;
+using tastylib::toString;
+using tastylib::randInt;
+using std::string;
+
+typedef ChunkedDeque<int>::SizeType SizeType;
+
+template<typename T, typename Pred, std::size_t ChunkBytes>
+string getDequeContent(const ChunkedDeque<T, Pred, ChunkBytes> &deque) {
+    string str;
+    deque.traverse([&](const SizeType pos, const T &val) {
+        UNUSED(pos);
+        str += toString(val);
+    });
+    return str;
+}
+
+TEST(ChunkedDeque, Basic) {
+    ChunkedDeque<int> deque;
+    EXPECT_TRUE(deque.isEmpty());
+    deque.insertBack(1);
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "1");
+    deque.insertFront(2);
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "21");
+    deque.insertBack(3);
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "213");
+    EXPECT_EQ(deque.getSize(), 3U);
+    EXPECT_EQ(deque.front(), 2);
+    EXPECT_EQ(deque.back(), 3);
+    EXPECT_EQ(deque[1], 1);
+    deque[1] = 4;
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "243");
+    EXPECT_EQ(deque.find(3), 2);
+    EXPECT_EQ(deque.find(1), -1);
+    deque.removeFront();
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "43");
+    deque.removeBack();
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "4");
+    deque.removeBack();
+    EXPECT_TRUE(deque.isEmpty());
+    deque.removeBack();
+    deque.removeFront();
+    EXPECT_TRUE(deque.isEmpty());
+    deque.insertFront(5);
+    deque.insertFront(6);
+    deque.clear();
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_STREQ(getDequeContent(deque).c_str(), "");
+}
+
+TEST(ChunkedDeque, Chunks) {
+    // 16 values per chunk
+    ChunkedDeque<int, std::equal_to<int>, 64> deque;
+    EXPECT_EQ(deque.CHUNK_CAPACITY, 16U);
+    for (int i = 0; i < 100; ++i) {
+        deque.insertFront(-i - 1);
+        deque.insertBack(i);
+    }
+    EXPECT_EQ(deque.getSize(), 200U);
+    for (SizeType i = 0; i < 200; ++i) {
+        EXPECT_EQ(deque[i], (int)i - 100);
+    }
+    // Drain from the front and refill from the back
+    for (int i = 0; i < 1000; ++i) {
+        deque.removeFront();
+        deque.insertBack(100 + i);
+    }
+    for (SizeType i = 0; i < 200; ++i) {
+        EXPECT_EQ(deque[i], (int)i + 900);
+    }
+    while (!deque.isEmpty()) {
+        deque.removeBack();
+    }
+    deque.insertBack(7);
+    EXPECT_EQ(deque.front(), 7);
+}
+
+TEST(ChunkedDeque, Random) {
+    ChunkedDeque<string, std::equal_to<string>, 64> deque;
+    std::deque<string> ans;
+    for (int i = 0; i < 50000; ++i) {
+        string s = toString(i);
+        switch (randInt(0, 3)) {
+            case 0:
+                deque.insertFront(s);
+                ans.push_front(s);
+                break;
+            case 1:
+                deque.insertBack(s);
+                ans.push_back(s);
+                break;
+            case 2:
+                deque.removeFront();
+                if (!ans.empty()) {
+                    ans.pop_front();
+                }
+                break;
+            default:
+                deque.removeBack();
+                if (!ans.empty()) {
+                    ans.pop_back();
+                }
+                break;
+        }
+        ASSERT_EQ(deque.getSize(), ans.size());
+        if (!ans.empty()) {
+            ASSERT_EQ(deque.front(), ans.front());
+            ASSERT_EQ(deque.back(), ans.back());
+        }
+    }
+    for (SizeType i = 0; i < ans.size(); ++i) {
+        EXPECT_EQ(deque[i], ans[i]);
+    }
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/ConcurrentHashTable.h"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef ConcurrentHashTable<int>::SizeType SizeType;
+
+namespace {
+
+/*
+An integer whose copy throws when it is negative.
+*/
+struct Fragile {
+    int val;
+
+    explicit Fragile(const int v) : val(v) {}
+
+    Fragile(const Fragile &other) : val(other.val) {
+        if (val < 0) {
+            throw std::runtime_error("Fragile copied");
+        }
+    }
+
+    bool operator==(const Fragile &other) const {
+        return val == other.val;
+    }
+};
+
+struct FragileHash {
+    std::size_t operator()(const Fragile &f) const {
+        return std::hash<int>()(f.val);
+    }
+};
+
+}
+
+TEST(ConcurrentHashTable, Basic) {
+    ConcurrentHashTable<int> table(0, 5);
+    EXPECT_EQ(table.getShardCount(), (SizeType)8);
+    EXPECT_EQ(ConcurrentHashTable<int>(0, 0).getShardCount(), (SizeType)1);
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_TRUE(table.insert(1));
+    EXPECT_TRUE(table.insert(2));
+    EXPECT_FALSE(table.insert(1));
+    EXPECT_EQ(table.getSize(), (SizeType)2);
+    EXPECT_TRUE(table.has(1));
+    EXPECT_FALSE(table.has(3));
+    int val = -1;
+    EXPECT_TRUE(table.find(2, val));
+    EXPECT_EQ(val, 2);
+    EXPECT_FALSE(table.find(3, val));
+    EXPECT_TRUE(table.remove(1));
+    EXPECT_FALSE(table.remove(1));
+    EXPECT_FALSE(table.has(1));
+    EXPECT_EQ(table.getSize(), (SizeType)1);
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_FALSE(table.has(2));
+}
+
+TEST(ConcurrentHashTable, Exception) {
+    // A throwing insertion must not leave the only shard locked
+    ConcurrentHashTable<Fragile, std::equal_to<Fragile>, FragileHash> table(0, 1);
+    const Fragile bad(-1), good(1);
+    EXPECT_THROW(table.insert(bad), std::runtime_error);
+    EXPECT_FALSE(table.has(bad));
+    EXPECT_TRUE(table.insert(good));
+    EXPECT_TRUE(table.has(good));
+    EXPECT_EQ(table.getSize(), (SizeType)1);
+}
+
+TEST(ConcurrentHashTable, Random) {
+    ConcurrentHashTable<string> table(100);
+    std::set<string> expect;
+    for (int i = 0; i < 20000; ++i) {
+        const string key = std::to_string(randInt(0, 5000));
+        if (randInt(0, 2) == 0) {
+            EXPECT_EQ(table.remove(key), expect.erase(key) == 1);
+        } else {
+            EXPECT_EQ(table.insert(key), expect.insert(key).second);
+        }
+        ASSERT_EQ(table.getSize(), expect.size());
+    }
+    for (int i = 0; i <= 5000; ++i) {
+        const string key = std::to_string(i);
+        EXPECT_EQ(table.has(key), expect.count(key) == 1);
+    }
+}
+
+TEST(ConcurrentHashTable, Concurrent) {
+    const int THREADS = 4;
+    const int KEYS = 20000;
+    ConcurrentHashTable<int> table(0, 4);
+    // The threads insert and remove the same keys. Exactly one of the
+    // racing insertions of a key succeeds, and so does a removal.
+    std::atomic<long long> inserted(0), removed(0);
+    vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            long long localInserted = 0, localRemoved = 0;
+            for (int i = 0; i < KEYS; ++i) {
+                const int key = (i * 7 + t) % KEYS;
+                localInserted += table.insert(key);
+                if (key % 3 == 0) {
+                    localRemoved += table.remove(key);
+                }
+                int val = -1;
+                if (table.find(key, val)) {
+                    EXPECT_EQ(val, key);
+                }
+            }
+            inserted += localInserted;
+            removed += localRemoved;
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(table.getSize(), (SizeType)(inserted - removed));
+    for (int key = 0; key < KEYS; ++key) {
+        if (key % 3 != 0) {
+            EXPECT_TRUE(table.has(key));
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "tastylib/ConcurrentQueue.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+using tastylib::ConcurrentQueue;
+using std::string;
+using std::vector;
+
+TEST(ConcurrentQueue, Basic) {
+    ConcurrentQueue<string> queue(3);
+    EXPECT_EQ(queue.getCapacity(), 4U);
+    EXPECT_TRUE(queue.isEmpty());
+    string val;
+    EXPECT_FALSE(queue.tryPop(val));
+    EXPECT_TRUE(queue.tryPush("a"));
+    EXPECT_TRUE(queue.tryPush("b"));
+    EXPECT_TRUE(queue.tryPush("c"));
+    EXPECT_TRUE(queue.tryPush("d"));
+    EXPECT_FALSE(queue.tryPush("e"));
+    EXPECT_EQ(queue.getSize(), 4U);
+    EXPECT_TRUE(queue.tryPop(val));
+    EXPECT_EQ(val, "a");
+    EXPECT_TRUE(queue.tryPush("e"));
+    for (const char *expect : {"b", "c", "d", "e"}) {
+        queue.pop(val);
+        EXPECT_EQ(val, expect);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.tryPop(val));
+
+    // Values left in the queue are destroyed by the destructor
+    queue.push("f");
+    queue.push("g");
+}
+
+/*
+A value that counts its copies.
+*/
+struct Counted {
+    static int copies;
+
+    Counted() {}
+
+    Counted(const Counted &) {
+        ++copies;
+    }
+
+    Counted(Counted &&) {}
+
+    Counted& operator=(const Counted &) {
+        ++copies;
+        return *this;
+    }
+
+    Counted& operator=(Counted &&) {
+        return *this;
+    }
+};
+
+int Counted::copies = 0;
+
+TEST(ConcurrentQueue, MovePop) {
+    ConcurrentQueue<Counted> queue(2);
+    queue.push(Counted());
+    EXPECT_EQ(Counted::copies, 1);  // Copied into the queue
+    Counted val;
+    EXPECT_TRUE(queue.tryPop(val));
+    EXPECT_EQ(Counted::copies, 1);  // Moved out of the queue
+}
+
+TEST(ConcurrentQueue, MultiThread) {
+    const int PRODUCERS = 4, CONSUMERS = 4, COUNT = 20000;
+    ConcurrentQueue<int> queue(64);
+    std::atomic<int> popped(0);
+    vector<vector<int>> got(CONSUMERS);
+    vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < COUNT; ++i) {
+                queue.push(p * COUNT + i);
+            }
+        });
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&, c]() {
+            int val;
+            while (popped.load() < PRODUCERS * COUNT) {
+                if (queue.tryPop(val)) {
+                    got[c].push_back(val);
+                    ++popped;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.isEmpty());
+
+    // Every value is popped exactly once, and each consumer sees
+    // the values of a producer in the order they were pushed
+    vector<int> seen(PRODUCERS * COUNT, 0);
+    for (const auto &vals : got) {
+        vector<int> last(PRODUCERS, -1);
+        for (int v : vals) {
+            ++seen[v];
+            EXPECT_LT(last[v / COUNT], v);
+            last[v / COUNT] = v;
+        }
+    }
+    for (int s : seen) {
+        EXPECT_EQ(s, 1);
+    }
+}
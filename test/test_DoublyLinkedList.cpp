@@ -1,11 +1,17 @@
 #include "gtest/gtest.h"
 #include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
 #include "tastylib/DoublyLinkedList.h"
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
 
 using tastylib::DoublyLinkedList;
 using tastylib::toString;
+using tastylib::randInt;
 using std::string;
+using std::vector;
 
 typedef DoublyLinkedList<int>::SizeType SizeType;
 
@@ -158,3 +164,226 @@ TEST(DoublyLinkedList, Sort) {
     list.sort();
     EXPECT_STREQ(getListContent(list).c_str(), "0112234");
 }
+
+TEST(DoublyLinkedList, Iterator) {
+    DoublyLinkedList<int> list;
+    EXPECT_TRUE(list.begin() == list.end());
+    for (int i = 1; i < 6; ++i) {
+        list.insertBack(i);
+    }
+    string str;
+    for (const auto &x : list) {
+        str += toString(x);
+    }
+    EXPECT_STREQ(str.c_str(), "12345");
+    str.clear();
+    for (auto it = list.end(); it != list.begin();) {
+        str += toString(*--it);
+    }
+    EXPECT_STREQ(str.c_str(), "54321");
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        *it *= 2;
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "246810");
+    const DoublyLinkedList<int> &cList = list;
+    DoublyLinkedList<int>::ConstIterator cit = list.begin();
+    EXPECT_TRUE(cit == cList.begin());
+    EXPECT_EQ(*++cit, 4);
+}
+
+TEST(DoublyLinkedList, IteratorInsertErase) {
+    DoublyLinkedList<int> list;
+    auto it = list.insert(list.end(), 3);
+    EXPECT_EQ(*it, 3);
+    list.insert(list.begin(), 1);
+    it = list.insert(it, 2);
+    EXPECT_EQ(*it, 2);
+    list.insert(list.end(), 4);
+    EXPECT_STREQ(getListContent(list).c_str(), "1234");
+    EXPECT_EQ(list.getSize(), (SizeType)4);
+    it = list.erase(it);
+    EXPECT_EQ(*it, 3);
+    EXPECT_STREQ(getListContent(list).c_str(), "134");
+    it = list.erase(list.begin());
+    EXPECT_EQ(*it, 3);
+    it = list.erase(--list.end());
+    EXPECT_TRUE(it == list.end());
+    EXPECT_STREQ(getListContent(list).c_str(), "3");
+    list.insertBack(4);
+    list.insertBack(5);
+    list.erase(list.begin(), list.end());
+    EXPECT_TRUE(list.isEmpty());
+    list.insertFront(1);
+    list.insertBack(2);
+    EXPECT_STREQ(getListContent(list).c_str(), "12");
+}
+
+TEST(DoublyLinkedList, FindIf) {
+    DoublyLinkedList<int> list;
+    for (int i = 0; i < 5; ++i) {
+        list.insertBack(i);
+    }
+    auto it = list.findIf([](const int &x) { return x > 2; });
+    EXPECT_EQ(*it, 3);
+    list.erase(it);
+    EXPECT_STREQ(getListContent(list).c_str(), "0124");
+    it = list.findIf([](const int &x) { return x > 10; });
+    EXPECT_TRUE(it == list.end());
+}
+
+TEST(DoublyLinkedList, Splice) {
+    DoublyLinkedList<int> list1, list2;
+    for (int i = 0; i < 3; ++i) {
+        list1.insertBack(i);
+        list2.insertBack(i + 5);
+    }
+    list1.splice(++list1.begin(), list2);
+    EXPECT_STREQ(getListContent(list1).c_str(), "056712");
+    EXPECT_EQ(list1.getSize(), (SizeType)6);
+    EXPECT_TRUE(list2.isEmpty());
+    list1.splice(list1.begin(), list2);
+    EXPECT_EQ(list1.getSize(), (SizeType)6);
+
+    // Move one node between lists
+    list2.splice(list2.end(), list1, list1.begin());
+    list2.splice(list2.end(), list1, --list1.end());
+    EXPECT_STREQ(getListContent(list1).c_str(), "5671");
+    EXPECT_STREQ(getListContent(list2).c_str(), "02");
+    EXPECT_EQ(list1.getSize(), (SizeType)4);
+    EXPECT_EQ(list2.getSize(), (SizeType)2);
+
+    // Move one node in the same list
+    list1.splice(list1.begin(), list1, --list1.end());
+    EXPECT_STREQ(getListContent(list1).c_str(), "1567");
+    list1.splice(list1.end(), list1, list1.begin());
+    EXPECT_STREQ(getListContent(list1).c_str(), "5671");
+    list1.splice(list1.begin(), list1, list1.begin());
+    EXPECT_STREQ(getListContent(list1).c_str(), "5671");
+    EXPECT_EQ(list1.getSize(), (SizeType)4);
+    string str;
+    for (auto it = list1.end(); it != list1.begin();) {
+        str += toString(*--it);
+    }
+    EXPECT_STREQ(str.c_str(), "1765");
+}
+
+TEST(DoublyLinkedList, Merge) {
+    DoublyLinkedList<int> list1, list2;
+    list1.merge(list2);
+    EXPECT_TRUE(list1.isEmpty());
+    for (int i = 0; i < 4; ++i) {
+        list2.insertBack(2 * i + 1);
+    }
+    list1.merge(list2);
+    EXPECT_STREQ(getListContent(list1).c_str(), "1357");
+    for (int i = 0; i < 5; ++i) {
+        list2.insertBack(2 * i);
+    }
+    list1.merge(list2);
+    EXPECT_STREQ(getListContent(list1).c_str(), "012345678");
+    EXPECT_EQ(list1.getSize(), (SizeType)9);
+    EXPECT_TRUE(list2.isEmpty());
+    EXPECT_EQ(*--list1.end(), 8);
+
+    // Merge in descending order
+    DoublyLinkedList<int> list3, list4;
+    list3.insertBack(9);
+    list3.insertBack(5);
+    list3.insertBack(1);
+    list4.insertBack(8);
+    list4.insertBack(5);
+    list4.insertBack(0);
+    list3.merge(list4, [](const int &a, const int &b) { return a > b; });
+    EXPECT_STREQ(getListContent(list3).c_str(), "985510");
+}
+
+/*
+Return true if the list has the same content as a vector
+when it is traversed forward and backward.
+*/
+template<typename T>
+bool sameContent(const DoublyLinkedList<T> &list, const vector<T> &ans) {
+    if (list.getSize() != ans.size()) {
+        return false;
+    }
+    auto it = list.begin();
+    for (std::size_t i = 0; i < ans.size(); ++i, ++it) {
+        if (!(*it == ans[i])) {
+            return false;
+        }
+    }
+    for (std::size_t i = ans.size(); i > 0; --i) {
+        if (!(*--it == ans[i - 1])) {
+            return false;
+        }
+    }
+    return it == list.begin();
+}
+
+TEST(DoublyLinkedList, SortRuns) {
+    const int n = 1000;
+    vector<vector<int>> cases(5);
+    for (int i = 0; i < n; ++i) {
+        cases[0].push_back(i);                 // Ascending
+        cases[1].push_back(n - i);             // Descending
+        cases[2].push_back(randInt(0, 50));    // Random with duplicates
+        cases[3].push_back(i % 7 ? i : -i);    // Nearly sorted
+        cases[4].push_back((i / 50) % 2 ? i : n - i);  // Alternating runs
+    }
+    for (const auto &vals : cases) {
+        DoublyLinkedList<int> list;
+        for (const auto &x : vals) {
+            list.insertBack(x);
+        }
+        vector<int> ans(vals);
+        std::sort(ans.begin(), ans.end());
+        list.sort();
+        EXPECT_TRUE(sameContent(list, ans));
+        list.insertBack(-n);
+        list.insertFront(n);
+        ans.insert(ans.begin(), n);
+        ans.push_back(-n);
+        EXPECT_TRUE(sameContent(list, ans));
+    }
+}
+
+TEST(DoublyLinkedList, SortStable) {
+    typedef std::pair<int, int> Pair;
+    auto cmp = [](const Pair &a, const Pair &b) {
+        return a.first < b.first;
+    };
+    DoublyLinkedList<Pair> list;
+    vector<Pair> ans;
+    for (int i = 0; i < 1000; ++i) {
+        // Descending keys with runs of equal keys
+        Pair p(i < 500 ? 10 - i / 50 : randInt(0, 10), i);
+        list.insertBack(p);
+        ans.push_back(p);
+    }
+    std::stable_sort(ans.begin(), ans.end(), cmp);
+    list.sort(cmp);
+    EXPECT_TRUE(sameContent(list, ans));
+}
+
+TEST(DoublyLinkedList, ParallelSort) {
+    typedef std::pair<int, int> Pair;
+    auto cmp = [](const Pair &a, const Pair &b) {
+        return a.first < b.first;
+    };
+    const int sizes[] = {0, 1, 100, 50000, 100003};
+    for (int size : sizes) {
+        for (unsigned threadNum = 1; threadNum <= 7; threadNum += 2) {
+            DoublyLinkedList<Pair> list;
+            vector<Pair> ans;
+            for (int i = 0; i < size; ++i) {
+                Pair p(randInt(0, 1000), i);
+                list.insertBack(p);
+                ans.push_back(p);
+            }
+            std::stable_sort(ans.begin(), ans.end(), cmp);
+            list.sort(cmp, threadNum);
+            EXPECT_EQ(list.getSize(), (std::size_t)size);
+            EXPECT_TRUE(sameContent(list, ans));
+        }
+    }
+}
@@ -0,0 +1,251 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/ExternalPriorityQueue.h"
+#include <functional>
+#include <iterator>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+typedef ExternalPriorityQueue<int>::SizeType SizeType;
+
+TEST(ExternalPriorityQueue, Basic) {
+    ExternalPriorityQueue<int> queue(4 * sizeof(int), sizeof(int));
+    EXPECT_EQ(queue.getBufferCapacity(), (SizeType)2);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_TRUE(queue.push(50));
+    EXPECT_TRUE(queue.push(20));
+    EXPECT_EQ(queue.getRunCount(), (SizeType)0);
+    EXPECT_TRUE(queue.push(30));  // The buffer is written to a run
+    EXPECT_EQ(queue.getRunCount(), (SizeType)1);
+    EXPECT_TRUE(queue.push(10));
+    EXPECT_FALSE(queue.isEmpty());
+    EXPECT_EQ(queue.getSize(), (SizeType)4);
+    EXPECT_EQ(queue.top(), 10);
+    EXPECT_TRUE(queue.pop());
+    EXPECT_EQ(queue.top(), 20);
+    int val = 0;
+    EXPECT_TRUE(queue.popTop(val));
+    EXPECT_EQ(val, 20);
+    EXPECT_TRUE(queue.popTop(val));
+    EXPECT_EQ(val, 30);
+    EXPECT_TRUE(queue.popTop(val));
+    EXPECT_EQ(val, 50);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.getRunCount(), (SizeType)0);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.getRunCount(), (SizeType)0);
+}
+
+struct Event {
+    long long time;
+    int id;
+};
+
+struct EventLessEqual {
+    bool operator()(const Event &a, const Event &b) const {
+        return a.time <= b.time;
+    }
+};
+
+TEST(ExternalPriorityQueue, Random) {
+    // A buffer of 64 elements, blocks of 8 elements and at most 8 - 2 runs
+    ExternalPriorityQueue<Event, EventLessEqual> queue(128 * sizeof(Event), 8 * sizeof(Event));
+    EXPECT_EQ(queue.getBufferCapacity(), (SizeType)64);
+    std::multiset<long long> ans;
+    for (int i = 0; i < 20000; ++i) {
+        if (randInt(0, 2) > 0 || ans.empty()) {
+            Event e{randInt(0, 100000), i};
+            EXPECT_TRUE(queue.push(e));
+            ans.insert(e.time);
+        } else {
+            EXPECT_EQ(queue.top().time, *ans.rbegin());  // Max-root
+            Event e{};
+            EXPECT_TRUE(queue.popTop(e));
+            EXPECT_EQ(e.time, *ans.rbegin());
+            ans.erase(std::prev(ans.end()));
+        }
+        EXPECT_LE(queue.getRunCount(), (SizeType)6);
+        ASSERT_EQ(queue.getSize(), (SizeType)ans.size());
+    }
+    while (!ans.empty()) {
+        Event e{};
+        EXPECT_TRUE(queue.popTop(e));
+        EXPECT_EQ(e.time, *ans.rbegin());
+        ans.erase(std::prev(ans.end()));
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(ExternalPriorityQueue, Sorted) {
+    const int SIZE = 100000;
+    ExternalPriorityQueue<int> queue(1 << 14, 1 << 10);
+    vector<int> vals;
+    for (int i = 0; i < SIZE; ++i) {
+        vals.push_back(i);
+    }
+    randChange(vals);
+    for (const auto &x : vals) {
+        EXPECT_TRUE(queue.push(x));
+    }
+    EXPECT_GT(queue.getRunCount(), (SizeType)1);
+    int val;
+    for (int i = 0; i < SIZE; ++i) {
+        ASSERT_TRUE(queue.popTop(val));
+        ASSERT_EQ(val, i);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+/*
+Open the files of the runs by their names, so that a test
+can change them behind the queue.
+*/
+class NamedFiles {
+public:
+    ~NamedFiles() {
+        for (const auto &name : names) {
+            std::remove(name.c_str());
+        }
+    }
+
+    std::FILE* open(const char *mode) {
+        names.push_back("test_ExternalPriorityQueue_" + std::to_string(names.size()) + ".tmp");
+        std::fclose(std::fopen(names.back().c_str(), "wb"));
+        return std::fopen(names.back().c_str(), mode);
+    }
+
+    vector<string> names;
+};
+
+TEST(ExternalPriorityQueue, ReadError) {
+    NamedFiles files;
+    {
+        // A buffer of 32 elements and blocks of 4 elements
+        ExternalPriorityQueue<int> queue(64 * sizeof(int), 4 * sizeof(int), [&]() {
+            return files.open("w+b");
+        });
+        for (int i = 1; i <= 32; ++i) {
+            EXPECT_TRUE(queue.push(i));
+        }
+        EXPECT_TRUE(queue.push(100));  // 1 to 32 are written to a run
+        ASSERT_EQ(queue.getRunCount(), (SizeType)1);
+        // Empty the file, whose first block is in memory
+        const string name = files.names[0];
+        vector<char> bytes(32 * sizeof(int));
+        std::FILE *f = std::fopen(name.c_str(), "rb");
+        ASSERT_EQ(std::fread(bytes.data(), 1, bytes.size(), f), bytes.size());
+        std::fclose(f);
+        std::fclose(std::fopen(name.c_str(), "wb"));
+        int val = 0;
+        for (int i = 1; i <= 3; ++i) {
+            EXPECT_TRUE(queue.popTop(val));
+            EXPECT_EQ(val, i);
+        }
+        // Popping 4 needs the next block, which is not read
+        EXPECT_FALSE(queue.pop());
+        EXPECT_FALSE(queue.popTop(val));
+        EXPECT_EQ(val, 3);
+        EXPECT_EQ(queue.getSize(), (SizeType)30);
+        EXPECT_EQ(queue.top(), 4);
+        // Restore the file and retry
+        f = std::fopen(name.c_str(), "r+b");
+        ASSERT_EQ(std::fwrite(bytes.data(), 1, bytes.size(), f), bytes.size());
+        std::fclose(f);
+        for (int i = 4; i <= 32; ++i) {
+            ASSERT_TRUE(queue.popTop(val));
+            EXPECT_EQ(val, i);
+        }
+        EXPECT_TRUE(queue.popTop(val));
+        EXPECT_EQ(val, 100);
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST(ExternalPriorityQueue, WriteError) {
+    NamedFiles files;
+    {
+        // A buffer of 32 elements, blocks of 4 elements and at most 8 - 2 runs
+        bool writable = true;
+        ExternalPriorityQueue<int> queue(64 * sizeof(int), 4 * sizeof(int), [&]() {
+            return files.open(writable ? "w+b" : "rb");
+        });
+        const int SIZE = 7 * 32;
+        vector<int> vals;
+        for (int i = 0; i < SIZE; ++i) {
+            vals.push_back(i);
+        }
+        randChange(vals);
+        for (const auto &x : vals) {
+            EXPECT_TRUE(queue.push(x));
+        }
+        EXPECT_EQ(queue.getRunCount(), (SizeType)6);
+        // The runs cannot be merged, nor the buffer written
+        writable = false;
+        EXPECT_FALSE(queue.push(SIZE));
+        EXPECT_FALSE(queue.push(SIZE));
+        EXPECT_EQ(queue.getSize(), (SizeType)SIZE);
+        EXPECT_EQ(queue.getRunCount(), (SizeType)6);
+        writable = true;
+        EXPECT_TRUE(queue.push(SIZE));
+        EXPECT_LE(queue.getRunCount(), (SizeType)6);
+        int val;
+        for (int i = 0; i <= SIZE; ++i) {
+            ASSERT_TRUE(queue.popTop(val));
+            ASSERT_EQ(val, i);
+        }
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST(ExternalPriorityQueue, MergeError) {
+    NamedFiles files;
+    {
+        // A buffer of 32 elements, blocks of 4 elements and at most 8 - 2 runs
+        ExternalPriorityQueue<int> queue(64 * sizeof(int), 4 * sizeof(int), [&]() {
+            return files.open("w+b");
+        });
+        const int SIZE = 7 * 32;
+        for (int i = 0; i < SIZE; ++i) {
+            EXPECT_TRUE(queue.push(i));
+        }
+        ASSERT_EQ(queue.getRunCount(), (SizeType)6);
+        // Cut the first run, which holds 0 to 31, after its second block,
+        // so the merge fails after some elements are written
+        const string name = files.names[0];
+        vector<char> bytes(32 * sizeof(int));
+        std::FILE *f = std::fopen(name.c_str(), "rb");
+        ASSERT_EQ(std::fread(bytes.data(), 1, bytes.size(), f), bytes.size());
+        std::fclose(f);
+        f = std::fopen(name.c_str(), "wb");
+        ASSERT_EQ(std::fwrite(bytes.data(), 1, 8 * sizeof(int), f), 8 * sizeof(int));
+        std::fclose(f);
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_FALSE(queue.push(SIZE));
+            EXPECT_EQ(queue.getRunCount(), (SizeType)6);
+            EXPECT_EQ(queue.getSize(), (SizeType)SIZE);
+            EXPECT_EQ(queue.top(), 0);
+        }
+        // Restore the file and retry
+        f = std::fopen(name.c_str(), "wb");
+        ASSERT_EQ(std::fwrite(bytes.data(), 1, bytes.size(), f), bytes.size());
+        std::fclose(f);
+        EXPECT_TRUE(queue.push(SIZE));
+        EXPECT_LE(queue.getRunCount(), (SizeType)6);
+        int val;
+        for (int i = 0; i <= SIZE; ++i) {
+            ASSERT_TRUE(queue.popTop(val));
+            ASSERT_EQ(val, i);
+        }
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "tastylib/FlatHashTable.h"
+#include "tastylib/util/convert.h"
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+
+using tastylib::FlatHashTable;
+using tastylib::toString;
+using std::string;
+
+typedef FlatHashTable<string>::SizeType SizeType;
+
+TEST(FlatHashTable, Basic) {
+    FlatHashTable<string> table;
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    table.insert("Alice");
+    table.insert("Alice");
+    table.insert("Darth");
+    EXPECT_EQ(table.getSize(), (SizeType)2);
+    EXPECT_TRUE(table.has("Alice"));
+    EXPECT_TRUE(table.has("Darth"));
+    table.remove("Darth");
+    table.remove("Bob");
+    EXPECT_TRUE(table.has("Alice"));
+    EXPECT_FALSE(table.has("Darth"));
+    EXPECT_EQ(table.getSize(), (SizeType)1);
+    table.clear();
+    EXPECT_EQ(table.getSize(), (SizeType)0);
+    EXPECT_FALSE(table.has("Alice"));
+}
+
+TEST(FlatHashTable, Grow) {
+    FlatHashTable<string> table;
+    for (int i = 0; i < 10000; ++i) {
+        table.insert(toString(i));
+    }
+    EXPECT_EQ(table.getSize(), (SizeType)10000);
+    EXPECT_LE(table.getSize(), table.getCapacity() - table.getCapacity() / 8);
+    bool res = true;
+    for (int i = 0; i < 10000; ++i) {
+        res = res && table.has(toString(i));
+    }
+    EXPECT_TRUE(res);
+    EXPECT_FALSE(table.has("10000"));
+
+    SizeType cap = table.getCapacity();
+    table.rehash(100000);
+    EXPECT_GT(table.getCapacity(), cap);
+    table.rehash(0);
+    EXPECT_EQ(table.getCapacity(), cap);
+    EXPECT_EQ(table.getSize(), (SizeType)10000);
+    EXPECT_TRUE(table.has("9999"));
+}
+
+TEST(FlatHashTable, Tombstone) {
+    // Keep the amount of elements small while inserting and removing
+    // many, so that the table is cleaned instead of growing
+    FlatHashTable<int> table(100);
+    SizeType cap = table.getCapacity();
+    for (int i = 0; i < 100000; ++i) {
+        table.insert(i);
+        if (i >= 50) {
+            table.remove(i - 50);
+        }
+        ASSERT_EQ(table.getSize(), (SizeType)(i >= 50 ? 50 : i + 1));
+    }
+    EXPECT_EQ(table.getCapacity(), cap);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(table.has(i), i >= 100000 - 50);
+    }
+
+    // A single group filled up to the maximum load, where the
+    // removed slots become tombstones
+    FlatHashTable<int> small;
+    for (int i = 0; i < 14; ++i) {
+        small.insert(i);
+    }
+    EXPECT_EQ(small.getCapacity(), (SizeType)16);
+    for (int i = 14; i < 10000; ++i) {
+        small.remove(i - 14);
+        small.insert(i);
+        ASSERT_EQ(small.getSize(), (SizeType)14);
+        ASSERT_FALSE(small.has(i - 14));
+        ASSERT_TRUE(small.has(i - 13));
+    }
+    EXPECT_EQ(small.getCapacity(), (SizeType)16);
+}
+
+TEST(FlatHashTable, Random) {
+    FlatHashTable<int> table;
+    std::set<int> expected;
+    std::srand(1);
+    for (int i = 0; i < 200000; ++i) {
+        int val = std::rand() % 5000;
+        switch (std::rand() % 3) {
+            case 0:
+                table.remove(val);
+                expected.erase(val);
+                break;
+            case 1:
+                table.insert(val);
+                expected.insert(val);
+                break;
+            default:
+                ASSERT_EQ(table.has(val), expected.count(val) > 0);
+                break;
+        }
+        ASSERT_EQ(table.getSize(), expected.size());
+    }
+}
+
+TEST(FlatHashTable, Find) {
+    FlatHashTable<string> table;
+    table.insert("Alice");
+    table.insert("Bob");
+    const string *p = table.find("Bob");
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(*p, "Bob");
+    EXPECT_EQ(table.find("Darth"), nullptr);
+    table.remove("Bob");
+    EXPECT_EQ(table.find("Bob"), nullptr);
+    const FlatHashTable<string> &ctable = table;
+    EXPECT_NE(ctable.find("Alice"), nullptr);
+}
+
+struct PtrHash {
+    std::size_t operator()(const std::unique_ptr<int> &p) const {
+        return std::hash<int>()(*p);
+    }
+};
+
+struct PtrEqual {
+    bool operator()(const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) const {
+        return *a == *b;
+    }
+};
+
+TEST(FlatHashTable, Move) {
+    FlatHashTable<std::unique_ptr<int>, PtrEqual, PtrHash> table;
+    for (int i = 0; i < 1000; ++i) {
+        table.insert(std::unique_ptr<int>(new int(i)));
+    }
+    EXPECT_EQ(table.getSize(), (SizeType)1000);
+    std::unique_ptr<int> key(new int(500));
+    EXPECT_TRUE(table.has(key));
+    table.remove(key);
+    EXPECT_FALSE(table.has(key));
+    EXPECT_EQ(table.getSize(), (SizeType)999);
+}
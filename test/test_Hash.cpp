@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "tastylib/Hash.h"
+#include "tastylib/util/string_ref.h"
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tastylib;
+using std::string;
+using std::vector;
+
+namespace {
+
+int countBits(std::uint64_t x) {
+    int n = 0;
+    for (; x; x &= x - 1) {
+        ++n;
+    }
+    return n;
+}
+
+enum class Color {
+    RED, GREEN
+};
+
+}
+
+TEST(Hash, MixInt) {
+    std::set<std::uint64_t> results;
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        results.insert(mixInt(i));
+    }
+    EXPECT_EQ(results.size(), (std::size_t)10000);
+    // Strided keys spread over the buckets selected by the low bits
+    const int BUCKETS = 256, KEYS = 256 * 64;
+    vector<int> cnt(BUCKETS, 0);
+    for (std::uint64_t i = 0; i < (std::uint64_t)KEYS; ++i) {
+        ++cnt[mixInt(i * 4096) & (BUCKETS - 1)];
+    }
+    for (int c : cnt) {
+        EXPECT_GT(c, 20);
+        EXPECT_LT(c, 120);
+    }
+}
+
+TEST(Hash, Avalanche) {
+    // Flipping one input bit flips about half of the output bits
+    long long flips = 0, trials = 0;
+    std::uint64_t x = 0x0123456789ABCDEFull;
+    for (int t = 0; t < 100; ++t, x = mixInt(x + t)) {
+        for (int b = 0; b < 64; ++b, ++trials) {
+            flips += countBits(mixInt(x) ^ mixInt(x ^ ((std::uint64_t)1 << b)));
+        }
+    }
+    EXPECT_NEAR((double)flips / trials, 32.0, 2.0);
+    flips = trials = 0;
+    unsigned char buf[64] = {};
+    for (std::size_t len = 1; len <= sizeof(buf); ++len) {
+        const std::uint64_t h = hashBytes(buf, len);
+        for (std::size_t i = 0; i < len * 8; ++i, ++trials) {
+            buf[i / 8] ^= (unsigned char)(1 << (i % 8));
+            flips += countBits(h ^ hashBytes(buf, len));
+            buf[i / 8] ^= (unsigned char)(1 << (i % 8));
+        }
+    }
+    EXPECT_NEAR((double)flips / trials, 32.0, 2.0);
+}
+
+TEST(Hash, Bytes) {
+    // Every length reads every byte, including the
+    // short paths and the tails of the long paths
+    vector<unsigned char> buf(300);
+    for (std::size_t i = 0; i < buf.size(); ++i) {
+        buf[i] = (unsigned char)(i * 7 + 1);
+    }
+    std::set<std::uint64_t> results;
+    for (std::size_t len = 0; len <= buf.size(); ++len) {
+        const std::uint64_t h = hashBytes(buf.data(), len);
+        EXPECT_EQ(h, hashBytes(buf.data(), len));
+        EXPECT_NE(h, hashBytes(buf.data(), len, 1));
+        results.insert(h);
+        for (std::size_t i = 0; i < len; ++i) {
+            ++buf[i];
+            EXPECT_NE(h, hashBytes(buf.data(), len));
+            --buf[i];
+        }
+    }
+    EXPECT_EQ(results.size(), buf.size() + 1);
+    // Equal bytes at different addresses
+    const string a = "The quick brown fox jumps over the lazy dog";
+    const string b = a;
+    EXPECT_EQ(hashBytes(a.data(), a.size()), hashBytes(b.data(), b.size()));
+}
+
+TEST(Hash, Hasher) {
+    const string str = "TastyLib";
+    EXPECT_EQ(Hasher<string>()(str), StringHash()(str));
+    EXPECT_EQ(Hasher<string>()(str), StringHash()("TastyLib"));
+    EXPECT_EQ(Hasher<string>()(str), StringHash()(StringRef(str)));
+    EXPECT_EQ(Hasher<int>()(42), (std::size_t)mixInt(42));
+    EXPECT_EQ(Hasher<long long>()(-1), (std::size_t)mixInt((std::uint64_t)-1));
+    EXPECT_NE(Hasher<Color>()(Color::RED), Hasher<Color>()(Color::GREEN));
+    int x = 0, y = 0;
+    EXPECT_NE(Hasher<int*>()(&x), Hasher<int*>()(&y));
+    EXPECT_NE(Hasher<double>()(1.0), Hasher<double>()(2.0));
+    // Combining depends on the order
+    typedef std::pair<int, string> Pair;
+    EXPECT_EQ(Hasher<Pair>()(Pair(1, "a")), hashCombine(Hasher<int>()(1), Hasher<string>()("a")));
+    EXPECT_NE(hashCombine(1, 2), hashCombine(2, 1));
+    typedef std::pair<int, int> IntPair;
+    EXPECT_NE(Hasher<IntPair>()(IntPair(1, 2)), Hasher<IntPair>()(IntPair(2, 1)));
+}
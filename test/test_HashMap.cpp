@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "tastylib/HashMap.h"
+#include "tastylib/util/string_ref.h"
+#include "tastylib/util/convert.h"
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+
+using tastylib::HashMap;
+using tastylib::StringRef;
+using tastylib::StringHash;
+using tastylib::StringEqual;
+using tastylib::toString;
+using std::string;
+
+typedef HashMap<int, string>::SizeType SizeType;
+
+TEST(HashMap, Basic) {
+    HashMap<int, string> map;
+    EXPECT_TRUE(map.isEmpty());
+    map[1] = "one";
+    map[2] = "two";
+    EXPECT_EQ(map.getSize(), (SizeType)2);
+    EXPECT_TRUE(map.has(1));
+    EXPECT_FALSE(map.has(3));
+    ASSERT_NE(map.find(2), nullptr);
+    EXPECT_EQ(*map.find(2), "two");
+    EXPECT_EQ(map.find(3), nullptr);
+    EXPECT_EQ(map[3], "");
+    EXPECT_EQ(map.getSize(), (SizeType)3);
+    map.remove(3);
+    map.remove(4);
+    EXPECT_EQ(map.getSize(), (SizeType)2);
+    EXPECT_FALSE(map.has(3));
+    const HashMap<int, string> &cmap = map;
+    ASSERT_NE(cmap.find(1), nullptr);
+    EXPECT_EQ(*cmap.find(1), "one");
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.has(1));
+}
+
+TEST(HashMap, Emplace) {
+    HashMap<int, string> map;
+    auto res = map.tryEmplace(1, 3, 'a');
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(*res.first, "aaa");
+    res = map.tryEmplace(1, 5, 'b');
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(*res.first, "aaa");
+
+    EXPECT_FALSE(map.insertOrAssign(1, "bbb"));
+    EXPECT_EQ(*map.find(1), "bbb");
+    EXPECT_TRUE(map.insertOrAssign(2, "ccc"));
+    EXPECT_EQ(*map.find(2), "ccc");
+
+    // The mapped value is not moved from if the key exists
+    string val("ddd");
+    EXPECT_FALSE(map.tryEmplace(2, std::move(val)).second);
+    EXPECT_EQ(val, "ddd");
+
+    HashMap<int, std::unique_ptr<int>> ptrs;
+    ptrs.tryEmplace(1, new int(10));
+    ptrs.insertOrAssign(2, std::unique_ptr<int>(new int(20)));
+    ptrs.insertOrAssign(1, std::unique_ptr<int>(new int(30)));
+    for (int i = 3; i < 1000; ++i) {
+        ptrs.tryEmplace(i, new int(i));
+    }
+    EXPECT_EQ(**ptrs.find(1), 30);
+    EXPECT_EQ(**ptrs.find(2), 20);
+    EXPECT_EQ(**ptrs.find(999), 999);
+}
+
+TEST(HashMap, StringKey) {
+    HashMap<string, int, StringEqual, StringHash> map;
+    map["Alice"] = 1;
+    map[string("Bob")] = 2;
+    map[StringRef("Darth")] = 3;
+    EXPECT_EQ(map.getSize(), (SizeType)3);
+
+    // Look up by a part of a buffer without constructing a std::string
+    const char buf[] = "AliceBobDarth";
+    ASSERT_NE(map.find(StringRef(buf, 5)), nullptr);
+    EXPECT_EQ(*map.find(StringRef(buf, 5)), 1);
+    EXPECT_EQ(*map.find(StringRef(buf + 5, 3)), 2);
+    EXPECT_EQ(*map.find(StringRef(buf + 8, 5)), 3);
+    EXPECT_FALSE(map.has(StringRef(buf, 4)));
+    EXPECT_TRUE(map.has("Bob"));
+    EXPECT_TRUE(map.has(string("Darth")));
+
+    ++map[StringRef(buf, 5)];
+    EXPECT_EQ(*map.find("Alice"), 2);
+    map.remove(StringRef(buf + 5, 3));
+    EXPECT_FALSE(map.has("Bob"));
+
+    int sum = 0;
+    map.traverse([&](const string &key, int &val) {
+        sum += val;
+        val = (int)key.size();
+    });
+    EXPECT_EQ(sum, 5);
+    EXPECT_EQ(*map.find("Darth"), 5);
+}
+
+TEST(HashMap, Random) {
+    HashMap<int, int> map;
+    std::map<int, int> expected;
+    std::srand(1);
+    for (int i = 0; i < 200000; ++i) {
+        int key = std::rand() % 5000;
+        switch (std::rand() % 4) {
+            case 0:
+                map.remove(key);
+                expected.erase(key);
+                break;
+            case 1:
+                map.insertOrAssign(key, i);
+                expected[key] = i;
+                break;
+            case 2:
+                map[key] += i;
+                expected[key] += i;
+                break;
+            default: {
+                const int *p = map.find(key);
+                auto it = expected.find(key);
+                ASSERT_EQ(p != nullptr, it != expected.end());
+                if (p) {
+                    ASSERT_EQ(*p, it->second);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(map.getSize(), expected.size());
+    }
+    long long sum = 0, expectedSum = 0;
+    map.traverse([&](const int &key, const int &val) {
+        sum += key + val;
+    });
+    for (const auto &kv : expected) {
+        expectedSum += kv.first + kv.second;
+    }
+    EXPECT_EQ(sum, expectedSum);
+}
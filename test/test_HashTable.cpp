@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "tastylib/HashTable.h"
 #include "tastylib/util/convert.h"
+#include <cstdlib>
+#include <set>
 #include <string>
 
 using tastylib::HashTable;
@@ -61,3 +63,97 @@ TEST(HashTable, Rehash) {
         EXPECT_TRUE(res);
     }
 }
+
+TEST(HashTable, Find) {
+    HashTable<string> table;
+    table.insert("Alice");
+    table.insert("Bob");
+    const string *p = table.find("Bob");
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(*p, "Bob");
+    EXPECT_EQ(table.find("Darth"), nullptr);
+    table.remove("Bob");
+    EXPECT_EQ(table.find("Bob"), nullptr);
+    const HashTable<string> &ctable = table;
+    EXPECT_NE(ctable.find("Alice"), nullptr);
+}
+
+TEST(HashTable, Grow) {
+    HashTable<int> table;
+    SizeType num = table.getBucketNum();
+    EXPECT_EQ(num, (SizeType)8);
+    for (int i = 0; i < 8; ++i) {
+        table.insert(i);
+    }
+    EXPECT_FALSE(table.isGrowing());
+    table.insert(8);
+    EXPECT_TRUE(table.isGrowing());
+    EXPECT_EQ(table.getBucketNum(), (SizeType)16);
+
+    // The pointers stay valid while the buckets are moved
+    const int *p = table.find(3);
+    ASSERT_NE(p, nullptr);
+    bool growing = false;
+    for (int i = 9; i < 100000; ++i) {
+        table.insert(i);
+        growing = growing || table.isGrowing();
+        ASSERT_LE(table.getSize(), 2 * table.getBucketNum());
+    }
+    EXPECT_TRUE(growing);
+    EXPECT_EQ(table.find(3), p);
+    EXPECT_EQ(table.getSize(), (SizeType)100000);
+    EXPECT_GE(table.getBucketNum(), (SizeType)65536);
+    bool res = true;
+    for (int i = 0; i < 100000; ++i) {
+        res = res && table.has(i);
+    }
+    EXPECT_TRUE(res);
+    EXPECT_FALSE(table.has(100000));
+
+    // Clear in the middle of a growth
+    for (int i = 100000; !table.isGrowing(); ++i) {
+        table.insert(i);
+    }
+    table.clear();
+    EXPECT_FALSE(table.isGrowing());
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_FALSE(table.has(3));
+    for (int i = 0; i < 100000; ++i) {
+        table.insert(i);
+    }
+    p = table.find(3);
+
+    table.rehash(8);
+    EXPECT_FALSE(table.isGrowing());
+    EXPECT_EQ(table.find(3), p);
+    EXPECT_TRUE(table.has(99999));
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+}
+
+TEST(HashTable, Random) {
+    HashTable<int> table;
+    std::set<int> expected;
+    std::srand(1);
+    for (int i = 0; i < 200000; ++i) {
+        int val = std::rand() % 20000;
+        switch (std::rand() % 4) {
+            case 0:
+                table.remove(val);
+                expected.erase(val);
+                break;
+            case 1:
+            case 2:
+                table.insert(val);
+                expected.insert(val);
+                break;
+            default:
+                ASSERT_EQ(table.has(val), expected.count(val) > 0);
+                break;
+        }
+        ASSERT_EQ(table.getSize(), expected.size());
+    }
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_EQ(table.has(i), expected.count(i) > 0);
+    }
+}
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
+#include "tastylib/IndexableSkipList.h"
+#include <string>
+#include <vector>
+
+using tastylib::IndexableSkipList;
+using tastylib::toString;
+using tastylib::randInt;
+using std::string;
+using std::vector;
+
+typedef IndexableSkipList<int>::SizeType SizeType;
+
+template<typename T>
+string getListContent(const IndexableSkipList<T> &list) {
+    string str;
+    list.traverse([&](const SizeType pos, const T &val) {
+        UNUSED(pos);
+        str += toString(val);
+    });
+    return str;
+}
+
+TEST(IndexableSkipList, Basic) {
+    IndexableSkipList<int> list;
+    EXPECT_TRUE(list.isEmpty());
+    list.insertBack(1);
+    EXPECT_STREQ(getListContent(list).c_str(), "1");
+    list.insertFront(2);
+    EXPECT_STREQ(getListContent(list).c_str(), "21");
+    list.insert(1, 3);
+    EXPECT_STREQ(getListContent(list).c_str(), "231");
+    list.insert(100, 4);
+    EXPECT_STREQ(getListContent(list).c_str(), "2314");
+    EXPECT_EQ(list.getSize(), 4U);
+    EXPECT_EQ(list.at(0), 2);
+    EXPECT_EQ(list.at(3), 4);
+    list.at(2) = 5;
+    EXPECT_STREQ(getListContent(list).c_str(), "2354");
+    EXPECT_EQ(list.find(5), 2);
+    EXPECT_EQ(list.find(9), -1);
+    list.remove(1);
+    EXPECT_STREQ(getListContent(list).c_str(), "254");
+    list.remove(3);
+    EXPECT_STREQ(getListContent(list).c_str(), "254");
+    list.removeFront();
+    EXPECT_STREQ(getListContent(list).c_str(), "54");
+    list.removeBack();
+    EXPECT_STREQ(getListContent(list).c_str(), "5");
+    list.removeBack();
+    EXPECT_TRUE(list.isEmpty());
+    list.removeBack();
+    list.removeFront();
+    EXPECT_TRUE(list.isEmpty());
+    list.insertBack(7);
+    list.insertBack(8);
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_STREQ(getListContent(list).c_str(), "");
+}
+
+TEST(IndexableSkipList, Iterator) {
+    IndexableSkipList<int> list;
+    for (int i = 0; i < 5; ++i) {
+        list.insertBack(i);
+    }
+    int expect = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        EXPECT_EQ(*it, expect++);
+    }
+    auto it = list.end();
+    for (int i = 4; i >= 0; --i) {
+        EXPECT_EQ(*--it, i);
+    }
+    EXPECT_TRUE(it == list.begin());
+    for (auto &v : list) {
+        v *= 2;
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "02468");
+    const IndexableSkipList<int> &clist = list;
+    IndexableSkipList<int>::ConstIterator cit = clist.begin();
+    EXPECT_EQ(*cit, 0);
+}
+
+TEST(IndexableSkipList, RandomEdit) {
+    IndexableSkipList<int> list;
+    vector<int> ans;
+    for (int i = 0; i < 20000; ++i) {
+        if (ans.empty() || randInt(0, 2) > 0) {
+            int pos = randInt(0, (int)ans.size());
+            list.insert(pos, i);
+            ans.insert(ans.begin() + pos, i);
+        } else {
+            int pos = randInt(0, (int)ans.size() - 1);
+            list.remove(pos);
+            ans.erase(ans.begin() + pos);
+        }
+        if (i % 1000 == 0) {
+            ASSERT_EQ(list.getSize(), ans.size());
+            for (SizeType j = 0; j < ans.size(); ++j) {
+                ASSERT_EQ(list.at(j), ans[j]);
+            }
+            auto it = list.end();
+            for (auto rit = ans.rbegin(); rit != ans.rend(); ++rit) {
+                ASSERT_EQ(*--it, *rit);
+            }
+        }
+    }
+    list.traverse([&](const SizeType pos, const int &val) {
+        EXPECT_EQ(val, ans[pos]);
+    });
+}
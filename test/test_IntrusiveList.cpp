@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/IntrusiveList.h"
+#include <string>
+#include <vector>
+
+using tastylib::IntrusiveList;
+using tastylib::IntrusiveListHook;
+using tastylib::toString;
+using std::string;
+using std::vector;
+
+namespace {
+
+struct Item {
+    int val;
+    IntrusiveListHook hookA;
+    IntrusiveListHook hookB;
+
+    explicit Item(const int v = 0) : val(v) {}
+};
+
+typedef IntrusiveList<Item, &Item::hookA> ListA;
+typedef IntrusiveList<Item, &Item::hookB> ListB;
+
+template<typename List>
+string getListContent(const List &list) {
+    string str;
+    list.traverse([&](const std::size_t pos, const Item &item) {
+        UNUSED(pos);
+        str += toString(item.val);
+    });
+    return str;
+}
+
+}
+
+TEST(IntrusiveList, Basic) {
+    vector<Item> items;
+    for (int i = 0; i < 5; ++i) {
+        items.push_back(Item(i));
+    }
+    ListA list;
+    EXPECT_TRUE(list.isEmpty());
+    list.insertBack(items[1]);
+    list.insertBack(items[2]);
+    list.insertFront(items[0]);
+    EXPECT_STREQ(getListContent(list).c_str(), "012");
+    EXPECT_EQ(list.getSize(), 3U);
+    EXPECT_EQ(list.front().val, 0);
+    EXPECT_EQ(list.back().val, 2);
+    list.front().val = 5;
+    const ListA &clist = list;
+    EXPECT_EQ(clist.front().val, 5);
+    EXPECT_EQ(&clist.back(), &items[2]);
+    list.front().val = 0;
+    EXPECT_TRUE(items[1].hookA.isLinked());
+    EXPECT_FALSE(items[3].hookA.isLinked());
+    list.insert(list.iteratorTo(items[2]), items[3]);
+    EXPECT_STREQ(getListContent(list).c_str(), "0132");
+    list.remove(items[1]);
+    EXPECT_STREQ(getListContent(list).c_str(), "032");
+    EXPECT_FALSE(items[1].hookA.isLinked());
+    list.remove(items[1]);  // Not linked, nothing happens
+    EXPECT_EQ(list.getSize(), 3U);
+    list.moveToFront(items[2]);
+    EXPECT_STREQ(getListContent(list).c_str(), "203");
+    list.removeFront();
+    EXPECT_STREQ(getListContent(list).c_str(), "03");
+    list.removeBack();
+    EXPECT_STREQ(getListContent(list).c_str(), "0");
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_FALSE(items[0].hookA.isLinked());
+    list.removeFront();
+    list.removeBack();
+    EXPECT_TRUE(list.isEmpty());
+}
+
+TEST(IntrusiveList, Iterator) {
+    vector<Item> items(5);
+    ListA list;
+    for (int i = 0; i < 5; ++i) {
+        items[i].val = i;
+        list.insertBack(items[i]);
+    }
+    int expect = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        EXPECT_EQ(it->val, expect++);
+    }
+    auto it = list.end();
+    for (int i = 4; i >= 0; --i) {
+        EXPECT_EQ((*--it).val, i);
+    }
+    EXPECT_TRUE(it == list.begin());
+    for (auto &item : list) {
+        item.val *= 2;
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "02468");
+    it = list.begin();
+    while (it != list.end()) {
+        it = (it->val % 4 == 0 ? list.erase(it) : ++it);
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "26");
+    const ListA &clist = list;
+    ListA::ConstIterator cit = clist.begin();
+    EXPECT_EQ(cit->val, 2);
+    list.clear();
+}
+
+TEST(IntrusiveList, SeveralLists) {
+    vector<Item> items(6);
+    ListA listA;
+    ListB listB;
+    for (int i = 0; i < 6; ++i) {
+        items[i].val = i;
+        listA.insertBack(items[i]);
+        if (i % 2) {
+            listB.insertFront(items[i]);
+        }
+    }
+    EXPECT_STREQ(getListContent(listA).c_str(), "012345");
+    EXPECT_STREQ(getListContent(listB).c_str(), "531");
+    listA.remove(items[3]);
+    EXPECT_STREQ(getListContent(listA).c_str(), "01245");
+    EXPECT_STREQ(getListContent(listB).c_str(), "531");
+    listB.remove(items[5]);
+    EXPECT_STREQ(getListContent(listA).c_str(), "01245");
+    EXPECT_STREQ(getListContent(listB).c_str(), "31");
+
+    // Copying an object does not copy its links
+    Item copy(items[1]);
+    EXPECT_FALSE(copy.hookA.isLinked());
+    EXPECT_FALSE(copy.hookB.isLinked());
+    listA.clear();
+    listB.clear();
+}
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "tastylib/LruCache.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+
+using tastylib::LruCache;
+using tastylib::LfuCache;
+using tastylib::toString;
+using tastylib::randInt;
+using std::string;
+using std::vector;
+
+TEST(LruCache, Basic) {
+    vector<string> evicted;
+    LruCache<string, int> cache(3, [&](const string &key, const int &val) {
+        evicted.push_back(key + toString(val));
+    });
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.getCapacity(), 3U);
+    EXPECT_EQ(cache.get("a"), nullptr);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.put("c", 3);
+    EXPECT_EQ(cache.getSize(), 3U);
+    ASSERT_NE(cache.get("a"), nullptr);  // Order: a c b
+    EXPECT_EQ(*cache.get("a"), 1);
+    cache.put("d", 4);  // Evicts b
+    ASSERT_EQ(evicted.size(), 1U);
+    EXPECT_EQ(evicted[0], "b2");
+    EXPECT_FALSE(cache.has("b"));
+    EXPECT_TRUE(cache.has("c"));  // has() does not refresh c
+    cache.put("a", 5);  // Order: a d c
+    EXPECT_EQ(*cache.get("a"), 5);
+    cache.put("e", 6);  // Evicts c
+    EXPECT_EQ(evicted.back(), "c3");
+    *cache.get("d") = 7;
+    cache.remove("d");
+    cache.remove("z");
+    EXPECT_EQ(cache.getSize(), 2U);
+    EXPECT_EQ(evicted.size(), 2U);
+    cache.clear();
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(evicted.size(), 2U);
+}
+
+TEST(LruCache, Random) {
+    const int CAPACITY = 50;
+    LruCache<int, int> cache(CAPACITY);
+    std::list<std::pair<int, int>> ans;  // From the most to the least recently used
+    auto findAns = [&](const int key) {
+        for (auto it = ans.begin(); it != ans.end(); ++it) {
+            if (it->first == key) {
+                return it;
+            }
+        }
+        return ans.end();
+    };
+    for (int i = 0; i < 20000; ++i) {
+        int key = randInt(0, 100);
+        auto it = findAns(key);
+        if (randInt(0, 1)) {
+            int *v = cache.get(key);
+            ASSERT_EQ(v == nullptr, it == ans.end());
+            if (v) {
+                ASSERT_EQ(*v, it->second);
+                ans.splice(ans.begin(), ans, it);
+            }
+        } else {
+            cache.put(key, i);
+            if (it != ans.end()) {
+                ans.erase(it);
+            } else if ((int)ans.size() == CAPACITY) {
+                ans.pop_back();
+            }
+            ans.emplace_front(key, i);
+        }
+        ASSERT_EQ(cache.getSize(), ans.size());
+    }
+}
+
+TEST(LfuCache, Basic) {
+    vector<string> evicted;
+    LfuCache<string, int> cache(3, [&](const string &key, const int &val) {
+        evicted.push_back(key + toString(val));
+    });
+    EXPECT_TRUE(cache.isEmpty());
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.put("c", 3);
+    EXPECT_EQ(*cache.get("a"), 1);  // a: 2 uses
+    EXPECT_EQ(*cache.get("a"), 1);  // a: 3 uses
+    EXPECT_EQ(*cache.get("b"), 2);  // b: 2 uses
+    cache.put("d", 4);  // Evicts c with 1 use
+    ASSERT_EQ(evicted.size(), 1U);
+    EXPECT_EQ(evicted[0], "c3");
+    cache.put("e", 5);  // Evicts d with 1 use
+    EXPECT_EQ(evicted.back(), "d4");
+    EXPECT_NE(cache.get("e"), nullptr);  // e: 2 uses, more recent than b
+    cache.put("f", 6);  // Evicts b, the least recent of 2 uses
+    EXPECT_EQ(evicted.back(), "b2");
+    EXPECT_TRUE(cache.has("a"));
+    EXPECT_TRUE(cache.has("e"));
+    EXPECT_TRUE(cache.has("f"));
+    cache.put("f", 7);  // f: 2 uses
+    cache.remove("e");
+    cache.remove("z");
+    EXPECT_EQ(cache.getSize(), 2U);
+    cache.put("g", 8);
+    cache.put("h", 9);  // Evicts g
+    EXPECT_EQ(evicted.back(), "g8");
+    EXPECT_EQ(*cache.get("f"), 7);
+    cache.clear();
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(LfuCache, Random) {
+    const int CAPACITY = 30;
+    LfuCache<int, int> cache(CAPACITY);
+    // key -> (value, use count, last use time)
+    std::map<int, vector<int>> ans;
+    for (int i = 0; i < 20000; ++i) {
+        int key = randInt(0, 60);
+        auto it = ans.find(key);
+        if (randInt(0, 1)) {
+            int *v = cache.get(key);
+            ASSERT_EQ(v == nullptr, it == ans.end());
+            if (v) {
+                ASSERT_EQ(*v, it->second[0]);
+                ++it->second[1];
+                it->second[2] = i;
+            }
+        } else {
+            cache.put(key, i);
+            if (it != ans.end()) {
+                it->second[0] = i;
+                ++it->second[1];
+                it->second[2] = i;
+            } else {
+                if ((int)ans.size() == CAPACITY) {
+                    auto victim = ans.begin();
+                    for (auto j = ans.begin(); j != ans.end(); ++j) {
+                        if (j->second[1] < victim->second[1]
+                            || (j->second[1] == victim->second[1]
+                                && j->second[2] < victim->second[2])) {
+                            victim = j;
+                        }
+                    }
+                    ASSERT_FALSE(cache.has(victim->first));
+                    ans.erase(victim);
+                }
+                ans[key] = {i, 1, i};
+            }
+        }
+        ASSERT_EQ(cache.getSize(), ans.size());
+    }
+    for (const auto &p : ans) {
+        EXPECT_TRUE(cache.has(p.first));
+    }
+}
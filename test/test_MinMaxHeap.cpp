@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/MinMaxHeap.h"
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::vector;
+
+typedef MinMaxHeap<int>::SizeType SizeType;
+
+TEST(MinMaxHeap, Basic) {
+    MinMaxHeap<int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)0);
+    heap.push(50);
+    EXPECT_EQ(heap.min(), 50);
+    EXPECT_EQ(heap.max(), 50);
+    heap.push(20);
+    EXPECT_EQ(heap.min(), 20);
+    EXPECT_EQ(heap.max(), 50);
+    heap.push(30);
+    heap.push(60);
+    EXPECT_FALSE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)4);
+    EXPECT_EQ(heap.min(), 20);
+    EXPECT_EQ(heap.max(), 60);
+    heap.popMax();
+    EXPECT_EQ(heap.max(), 50);
+    heap.popMin();
+    EXPECT_EQ(heap.min(), 30);
+    EXPECT_EQ(heap.popMaxTop(), 50);
+    EXPECT_EQ(heap.popMinTop(), 30);
+    EXPECT_TRUE(heap.isEmpty());
+    heap.push(1);
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(MinMaxHeap, Random) {
+    MinMaxHeap<int> heap;
+    std::multiset<int> ans;
+    for (int i = 0; i < 20000; ++i) {
+        int op = randInt(0, 3);
+        if (op <= 1 || ans.empty()) {
+            int x = randInt(0, 1000);
+            heap.push(x);
+            ans.insert(x);
+        } else if (op == 2) {
+            EXPECT_EQ(heap.popMinTop(), *ans.begin());
+            ans.erase(ans.begin());
+        } else {
+            EXPECT_EQ(heap.popMaxTop(), *ans.rbegin());
+            ans.erase(std::prev(ans.end()));
+        }
+        ASSERT_EQ(heap.getSize(), (SizeType)ans.size());
+        if (!ans.empty()) {
+            ASSERT_EQ(heap.min(), *ans.begin());
+            ASSERT_EQ(heap.max(), *ans.rbegin());
+        }
+    }
+}
+
+TEST(MinMaxHeap, Heapify) {
+    vector<int> vals;
+    for (int i = 0; i < 1000; ++i) {
+        vals.push_back(randInt(0, 100));
+    }
+    std::multiset<int> ans(vals.begin(), vals.end());
+    MinMaxHeap<int> heap(vals.begin(), vals.end());
+    EXPECT_EQ(heap.getSize(), (SizeType)1000);
+    while (!ans.empty()) {
+        EXPECT_EQ(heap.popMinTop(), *ans.begin());
+        ans.erase(ans.begin());
+        if (!ans.empty()) {
+            EXPECT_EQ(heap.popMaxTop(), *ans.rbegin());
+            ans.erase(std::prev(ans.end()));
+        }
+    }
+    EXPECT_TRUE(heap.isEmpty());
+    MinMaxHeap<int> empty(vals.begin(), vals.begin());
+    EXPECT_TRUE(empty.isEmpty());
+}
+
+struct PtrLess {
+    bool operator()(const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) const {
+        return *a < *b;
+    }
+};
+
+TEST(MinMaxHeap, Move) {
+    MinMaxHeap<std::unique_ptr<int>, PtrLess> heap;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 2) {
+            heap.emplace(new int(i));
+        } else {
+            heap.push(std::unique_ptr<int>(new int(i)));
+        }
+    }
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(*heap.popMinTop(), i);
+        EXPECT_EQ(*heap.popMaxTop(), 99 - i);
+    }
+    EXPECT_TRUE(heap.isEmpty());
+
+    MinMaxHeap<std::string, std::greater<std::string>> strHeap;  // Reversed order
+    strHeap.push("b");
+    strHeap.push(std::string("a"));
+    strHeap.push("c");
+    EXPECT_EQ(strHeap.min(), "c");
+    EXPECT_EQ(strHeap.max(), "a");
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/MultiQueue.h"
+#include <atomic>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace tastylib;
+using std::vector;
+
+typedef MultiQueue<int>::SizeType SizeType;
+
+namespace {
+
+/*
+An integer whose copy throws when it is negative.
+*/
+struct Fragile {
+    int val;
+
+    explicit Fragile(const int v) : val(v) {}
+
+    Fragile(const Fragile &other) : val(other.val) {
+        if (val < 0) {
+            throw std::runtime_error("Fragile copied");
+        }
+    }
+
+    Fragile& operator=(const Fragile &other) = default;
+
+    bool operator>=(const Fragile &other) const {
+        return val >= other.val;
+    }
+};
+
+}
+
+TEST(MultiQueue, Basic) {
+    MultiQueue<int> queue(4);
+    EXPECT_EQ(queue.getHeapCount(), (SizeType)8);
+    EXPECT_EQ(MultiQueue<int>(0).getHeapCount(), (SizeType)2);
+    EXPECT_TRUE(queue.isEmpty());
+    int val = -1;
+    EXPECT_FALSE(queue.tryPop(val));
+    EXPECT_EQ(val, -1);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_FALSE(queue.isEmpty());
+    EXPECT_EQ(queue.getSize(), (SizeType)2);
+    EXPECT_TRUE(queue.tryPop(val));
+    EXPECT_TRUE(val == 1 || val == 2);
+    int val2;
+    EXPECT_TRUE(queue.tryPop(val2));
+    EXPECT_EQ(val + val2, 3);
+    EXPECT_FALSE(queue.tryPop(val));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(MultiQueue, RelaxedOrder) {
+    const int SIZE = 10000;
+    MultiQueue<int> queue(2);
+    vector<int> add;
+    for (int i = 0; i < SIZE; ++i) {
+        add.push_back(i);
+    }
+    randChange(add);
+    for (const auto &x : add) {
+        queue.push(x);
+    }
+    // The popped elements are close to the priority order, and
+    // each element is popped exactly once.
+    std::set<int> rest(add.begin(), add.end());
+    long long rankSum = 0;
+    int val;
+    for (int i = 0; i < SIZE; ++i) {
+        ASSERT_TRUE(queue.tryPop(val));
+        auto it = rest.find(val);
+        ASSERT_TRUE(it != rest.end());
+        rankSum += std::distance(rest.begin(), it);  // Smaller elements in the queue
+        rest.erase(it);
+    }
+    EXPECT_FALSE(queue.tryPop(val));
+    EXPECT_LT(rankSum / SIZE, (long long)(10 * queue.getHeapCount()));
+}
+
+TEST(MultiQueue, MaxRoot) {
+    MultiQueue<int, std::less_equal<int>> queue(1, 1);
+    queue.push(1);
+    queue.push(3);
+    queue.push(2);
+    int val;
+    ASSERT_TRUE(queue.tryPop(val));
+    EXPECT_TRUE(val == 3 || val == 2);  // The root of one of two heaps
+}
+
+TEST(MultiQueue, Exception) {
+    // Throwing insertions must not leave the heaps locked
+    MultiQueue<Fragile> queue(1);
+    const Fragile bad(-1), good(1);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_THROW(queue.push(bad), std::runtime_error);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    queue.push(good);
+    Fragile res(0);
+    EXPECT_TRUE(queue.tryPop(res));
+    EXPECT_EQ(res.val, 1);
+}
+
+TEST(MultiQueue, Concurrent) {
+    const int THREADS = 4;
+    const int PER_THREAD = 20000;
+    MultiQueue<int> queue(THREADS);
+    std::atomic<long long> sum(0);
+    std::atomic<int> poppedCnt(0);
+    vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            long long localSum = 0;
+            int val;
+            for (int i = 0; i < PER_THREAD; ++i) {
+                queue.push(t * PER_THREAD + i);
+                if (i % 2 && queue.tryPop(val)) {
+                    localSum += val;
+                    ++poppedCnt;
+                }
+            }
+            sum += localSum;
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    int val;
+    while (queue.tryPop(val)) {
+        sum += val;
+        ++poppedCnt;
+    }
+    const long long total = (long long)THREADS * PER_THREAD;
+    EXPECT_EQ(poppedCnt.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/PairingHeap.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace tastylib;
+using std::vector;
+
+typedef PairingHeap<int>::SizeType SizeType;
+typedef PairingHeap<int>::Handle Handle;
+
+TEST(PairingHeap, Basic) {
+    PairingHeap<int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)0);
+    heap.push(50);
+    Handle h20 = heap.push(20);
+    heap.push(30);
+    EXPECT_FALSE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)3);
+    EXPECT_EQ(heap.top(), 20);
+    EXPECT_EQ(heap.topHandle(), h20);
+    EXPECT_EQ(heap.get(h20), 20);
+    heap.pop();
+    EXPECT_EQ(heap.top(), 30);
+    heap.pop();
+    EXPECT_EQ(heap.popTop(), 50);
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)0);
+    heap.push(10);
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+    heap.push(10);
+    EXPECT_EQ(heap.top(), 10);
+}
+
+TEST(PairingHeap, MaxRoot) {
+    PairingHeap<int, std::less_equal<int>> heap;
+    vector<int> add;
+    for (int i = 0; i < 1000; ++i) {
+        add.push_back(i);
+    }
+    randChange(add);
+    for (const auto &x : add) {
+        heap.push(x);
+    }
+    for (int i = 999; i >= 0; --i) {
+        EXPECT_EQ(heap.top(), i);
+        heap.pop();
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(PairingHeap, DecreaseKeyAndErase) {
+    PairingHeap<int> heap;
+    heap.push(10);
+    Handle h20 = heap.push(20);
+    Handle h30 = heap.push(30);
+    heap.pop();
+    EXPECT_TRUE(heap.decreaseKey(h30, 5));
+    EXPECT_EQ(heap.topHandle(), h30);
+    EXPECT_FALSE(heap.decreaseKey(h20, 25));  // Not a decrease
+    EXPECT_EQ(heap.get(h20), 20);
+    Handle h15 = heap.push(15);
+    heap.erase(h30);
+    EXPECT_EQ(heap.top(), 15);
+    heap.erase(h20);
+    EXPECT_EQ(heap.getSize(), (SizeType)1);
+    EXPECT_EQ(heap.topHandle(), h15);
+    heap.erase(h15);
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(PairingHeap, Meld) {
+    PairingHeap<int> heap1, heap2, heap3;
+    vector<int> ans;
+    vector<Handle> handles2;
+    for (int i = 0; i < 1000; ++i) {
+        int x = randInt(0, 10000);
+        ans.push_back(x);
+        if (i % 2) {
+            heap1.push(x);
+        } else {
+            handles2.push_back(heap2.push(x));
+        }
+    }
+    heap2.erase(handles2[0]);  // Leave a free node in the pool of heap2
+    heap2.push(ans[0]);
+    heap1.meld(heap2);
+    heap1.meld(heap1);
+    heap1.meld(heap3);
+    EXPECT_TRUE(heap2.isEmpty());
+    EXPECT_EQ(heap1.getSize(), (SizeType)1000);
+
+    // Handles of the melded heap stay valid
+    ans.push_back(-1);
+    std::sort(ans.begin(), ans.end());
+    Handle h = handles2.back();
+    int old = heap1.get(h);
+    EXPECT_TRUE(heap1.decreaseKey(h, -1));
+    ans.erase(std::find(ans.begin(), ans.end(), old));
+
+    // The melded heaps keep working
+    heap2.push(1);
+    EXPECT_EQ(heap2.popTop(), 1);
+    for (const auto &x : ans) {
+        EXPECT_EQ(heap1.popTop(), x);
+    }
+    EXPECT_TRUE(heap1.isEmpty());
+}
+
+TEST(PairingHeap, Random) {
+    PairingHeap<int> heap;
+    std::multimap<int, Handle> ans;  // Value -> handle
+    vector<Handle> live;
+    auto removeAns = [&](const Handle h, const int val) {
+        auto range = ans.equal_range(val);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == h) {
+                ans.erase(it);
+                return;
+            }
+        }
+        FAIL();
+    };
+    auto removeLive = [&](const Handle h) {
+        for (auto &x : live) {
+            if (x == h) {
+                x = live.back();
+                live.pop_back();
+                return;
+            }
+        }
+        FAIL();
+    };
+    for (int i = 0; i < 20000; ++i) {
+        int op = randInt(0, 4);
+        if (op <= 1 || live.empty()) {
+            int val = randInt(0, 1000);
+            Handle h = heap.push(val);
+            ans.insert(std::make_pair(val, h));
+            live.push_back(h);
+        } else if (op == 2) {
+            EXPECT_EQ(heap.top(), ans.begin()->first);
+            Handle h = heap.topHandle();
+            removeAns(h, heap.top());
+            removeLive(h);
+            heap.pop();
+        } else if (op == 3) {
+            Handle h = live[randInt(0, (int)live.size() - 1)];
+            removeAns(h, heap.get(h));
+            removeLive(h);
+            heap.erase(h);
+        } else {
+            Handle h = live[randInt(0, (int)live.size() - 1)];
+            int old = heap.get(h), val = old - randInt(0, 100);
+            removeAns(h, old);
+            ans.insert(std::make_pair(val, h));
+            EXPECT_TRUE(heap.decreaseKey(h, val));
+            EXPECT_EQ(heap.get(h), val);
+        }
+        EXPECT_EQ(heap.getSize(), (SizeType)ans.size());
+    }
+    while (!heap.isEmpty()) {
+        EXPECT_EQ(heap.top(), ans.begin()->first);
+        ans.erase(ans.begin());
+        heap.pop();
+    }
+}
+
+TEST(PairingHeap, NonTrivialValue) {
+    PairingHeap<std::string> heap;
+    for (int i = 0; i < 1000; ++i) {
+        heap.emplace(50, char('a' + randInt(0, 25)));
+    }
+    std::string last;
+    for (int i = 0; i < 500; ++i) {
+        std::string str = heap.popTop();
+        EXPECT_LE(last, str);
+        last = str;
+    }
+    // The remaining strings are destroyed by the destructor
+}
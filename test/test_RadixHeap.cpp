@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/RadixHeap.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+
+using namespace tastylib;
+using std::vector;
+
+typedef RadixHeap<unsigned, int>::SizeType SizeType;
+
+TEST(RadixHeap, Basic) {
+    RadixHeap<unsigned, std::string> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)0);
+    EXPECT_TRUE(heap.push(50, "a"));
+    EXPECT_TRUE(heap.push(20, "b"));
+    EXPECT_TRUE(heap.push(30, "c"));
+    EXPECT_FALSE(heap.isEmpty());
+    EXPECT_EQ(heap.getSize(), (SizeType)3);
+    EXPECT_EQ(heap.top().first, 20u);
+    EXPECT_EQ(heap.top().second, "b");
+    heap.pop();
+    EXPECT_EQ(heap.getMinPushKey(), 20u);
+    EXPECT_EQ(heap.top().first, 30u);
+    EXPECT_FALSE(heap.push(19, "d"));  // Smaller than the last popped key
+    EXPECT_TRUE(heap.push(20, "e"));
+    EXPECT_EQ(heap.getSize(), (SizeType)3);
+    auto item = heap.popTop();
+    EXPECT_EQ(item.first, 20u);
+    EXPECT_EQ(item.second, "e");
+    EXPECT_EQ(heap.popTop().second, "c");
+    EXPECT_EQ(heap.popTop().second, "a");
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_FALSE(heap.push(0, "f"));
+    heap.clear();
+    EXPECT_TRUE(heap.push(0, "f"));
+    EXPECT_EQ(heap.top().first, 0u);
+}
+
+TEST(RadixHeap, SignedKey) {
+    RadixHeap<std::int32_t, int> heap;
+    EXPECT_EQ(heap.getMinPushKey(), INT32_MIN);
+    vector<std::int32_t> keys = {INT32_MAX, -5, 0, INT32_MIN, 7, -1, -5};
+    for (SizeType i = 0; i < keys.size(); ++i) {
+        EXPECT_TRUE(heap.push(keys[i], (int)i));
+    }
+    std::sort(keys.begin(), keys.end());
+    for (const auto &k : keys) {
+        EXPECT_EQ(heap.top().first, k);
+        EXPECT_EQ(heap.popTop().first, k);
+    }
+    EXPECT_FALSE(heap.push(INT32_MAX - 1, 0));
+    EXPECT_TRUE(heap.push(INT32_MAX, 0));
+}
+
+TEST(RadixHeap, MoveOnlyValue) {
+    RadixHeap<std::uint64_t, std::unique_ptr<int>> heap;
+    for (int i = 0; i < 100; ++i) {
+        heap.push((std::uint64_t)randInt(0, 1000000) << 30, std::unique_ptr<int>(new int(i)));
+    }
+    std::uint64_t last = 0;
+    while (!heap.isEmpty()) {
+        auto item = heap.popTop();
+        EXPECT_LE(last, item.first);
+        EXPECT_TRUE(item.second != nullptr);
+        last = item.first;
+    }
+}
+
+TEST(RadixHeap, Monotone) {
+    RadixHeap<unsigned, unsigned> heap;
+    std::multiset<unsigned> ans;
+    for (int i = 0; i < 1000; ++i) {
+        unsigned k = randInt(0, 1000);
+        heap.push(k, k);
+        ans.insert(k);
+    }
+    // Pop the minimum and push larger keys, like Dijkstra's algorithm
+    for (int i = 0; i < 20000 && !ans.empty(); ++i) {
+        EXPECT_EQ(heap.top().first, *ans.begin());
+        auto item = heap.popTop();
+        EXPECT_EQ(item.first, *ans.begin());
+        EXPECT_EQ(item.second, item.first);
+        ans.erase(ans.begin());
+        int pushes = randInt(0, 2);
+        for (int j = 0; j < pushes; ++j) {
+            unsigned k = item.first + randInt(0, 1000);
+            EXPECT_TRUE(heap.push(k, k));
+            ans.insert(k);
+        }
+        EXPECT_EQ(heap.getSize(), (SizeType)ans.size());
+    }
+    while (!ans.empty()) {
+        EXPECT_EQ(heap.popTop().first, *ans.begin());
+        ans.erase(ans.begin());
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/TimingWheel.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace tastylib;
+using std::vector;
+
+typedef TimingWheel<int>::SizeType SizeType;
+typedef TimingWheel<int>::Time Time;
+typedef TimingWheel<int>::Handle Handle;
+
+TEST(TimingWheel, Basic) {
+    TimingWheel<int> wheel(100);
+    EXPECT_TRUE(wheel.isEmpty());
+    EXPECT_EQ(wheel.getTime(), (Time)100);
+    Handle h1 = wheel.schedule(110, 1);
+    Handle h2 = wheel.schedule(105, 2);
+    Handle h3 = wheel.schedule(1000, 3);
+    Handle h4 = wheel.schedule(50, 4);  // Already expired
+    EXPECT_EQ(wheel.getSize(), (SizeType)4);
+    EXPECT_TRUE(wheel.contains(h3));
+    EXPECT_TRUE(wheel.cancel(h3));
+    EXPECT_FALSE(wheel.contains(h3));
+    EXPECT_FALSE(wheel.cancel(h3));
+    vector<int> fired;
+    auto cb = [&](int val) {
+        fired.push_back(val);
+    };
+    EXPECT_EQ(wheel.advance(100, cb), (SizeType)0);
+    EXPECT_EQ(wheel.advance(105, cb), (SizeType)2);
+    EXPECT_EQ(fired, vector<int>({4, 2}));
+    EXPECT_FALSE(wheel.contains(h2));
+    EXPECT_FALSE(wheel.contains(h4));
+    EXPECT_FALSE(wheel.cancel(h2));
+    EXPECT_TRUE(wheel.contains(h1));
+    EXPECT_EQ(wheel.advance(2000, cb), (SizeType)1);
+    EXPECT_EQ(fired, vector<int>({4, 2, 1}));
+    EXPECT_EQ(wheel.getTime(), (Time)2000);
+    EXPECT_TRUE(wheel.isEmpty());
+
+    // A reused node does not match the old handle
+    Handle h5 = wheel.schedule(3000, 5);
+    EXPECT_NE(h1, h5);
+    EXPECT_FALSE(wheel.cancel(h1));
+    wheel.clear();
+    EXPECT_FALSE(wheel.contains(h5));
+    Handle h6 = wheel.schedule(3000, 6);
+    EXPECT_FALSE(wheel.contains(h5));
+    EXPECT_TRUE(wheel.contains(h6));
+}
+
+TEST(TimingWheel, Random) {
+    TimingWheel<int> wheel;
+    std::multimap<Time, int> ans;  // The expiration times of the pending timers
+    vector<Handle> handles;
+    vector<Time> expires;
+    Time now = 0;
+    for (int round = 0; round < 3000; ++round) {
+        int n = randInt(0, 20);
+        for (int i = 0; i < n; ++i) {
+            int range = randInt(0, 3);
+            Time delay = (range == 0 ? randInt(0, 300) :
+                          range == 1 ? randInt(0, 100000) :
+                          range == 2 ? randInt(0, 10000000) : ((Time)randInt(0, 8) << 30));
+            Time e = now + delay;
+            int id = (int)handles.size();
+            handles.push_back(wheel.schedule(e, id));
+            expires.push_back(e > now ? e : now + 1);
+            ans.insert(std::make_pair(expires.back(), id));
+        }
+        for (int i = 0; i < n / 2 && !ans.empty(); ++i) {
+            int id = randInt(0, (int)handles.size() - 1);
+            auto range = ans.equal_range(expires[id]);
+            bool pending = false;
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == id) {
+                    ans.erase(it);
+                    pending = true;
+                    break;
+                }
+            }
+            EXPECT_EQ(wheel.cancel(handles[id]), pending);
+        }
+        int step = randInt(0, 3);
+        now += (step == 0 ? randInt(0, 10) : step == 1 ? randInt(0, 1000) :
+                step == 2 ? randInt(0, 1000000) : ((Time)randInt(0, 4) << 30));
+        vector<int> fired;
+        wheel.advance(now, [&](int id) {
+            fired.push_back(id);
+        });
+        Time last = 0;
+        for (const auto &id : fired) {
+            ASSERT_LE(expires[id], now);
+            ASSERT_LE(last, expires[id]);
+            last = expires[id];
+            auto range = ans.equal_range(expires[id]);
+            auto it = range.first;
+            while (it != range.second && it->second != id) {
+                ++it;
+            }
+            ASSERT_TRUE(it != range.second);
+            ans.erase(it);
+        }
+        ASSERT_TRUE(ans.empty() || ans.begin()->first > now);
+        ASSERT_EQ(wheel.getSize(), (SizeType)ans.size());
+    }
+}
+
+TEST(TimingWheel, Callback) {
+    TimingWheel<std::unique_ptr<int>> wheel;
+    Handle h2 = wheel.schedule(20, std::unique_ptr<int>(new int(2)));
+    wheel.schedule(10, std::unique_ptr<int>(new int(1)));
+    wheel.schedule(10, std::unique_ptr<int>(new int(3)));
+    vector<int> fired;
+    // Reschedule and cancel timers in the callback
+    wheel.advance(100, [&](std::unique_ptr<int> &val) {
+        fired.push_back(*val);
+        if (*val == 1) {
+            EXPECT_TRUE(wheel.cancel(h2));
+            wheel.schedule(5, std::unique_ptr<int>(new int(4)));  // Fires at the next tick
+        }
+    });
+    std::sort(fired.begin(), fired.begin() + 2);
+    EXPECT_EQ(fired, vector<int>({1, 3, 4}));
+    EXPECT_TRUE(wheel.isEmpty());
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/random.h"
+#include "tastylib/TopK.h"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tastylib;
+using std::vector;
+
+typedef TopK<int>::SizeType SizeType;
+
+TEST(TopK, Basic) {
+    TopK<int> topK(3);
+    EXPECT_EQ(topK.getCapacity(), (SizeType)3);
+    EXPECT_TRUE(topK.isEmpty());
+    EXPECT_FALSE(topK.isFull());
+    EXPECT_TRUE(topK.offer(5));
+    EXPECT_TRUE(topK.offer(1));
+    EXPECT_TRUE(topK.offer(3));
+    EXPECT_TRUE(topK.isFull());
+    EXPECT_EQ(topK.getThreshold(), 1);
+    EXPECT_FALSE(topK.offer(0));
+    EXPECT_FALSE(topK.offer(1));  // Ties do not beat the threshold
+    EXPECT_TRUE(topK.offer(4));
+    EXPECT_EQ(topK.getThreshold(), 3);
+    EXPECT_EQ(topK.getSize(), (SizeType)3);
+    EXPECT_EQ(topK.extractSorted(), vector<int>({5, 4, 3}));
+    EXPECT_TRUE(topK.isEmpty());
+    EXPECT_TRUE(topK.offer(1));
+    topK.clear();
+    EXPECT_TRUE(topK.isEmpty());
+
+    TopK<int> zero(0);
+    EXPECT_FALSE(zero.offer(1));
+    vector<int> vals = {1, 2, 3};
+    EXPECT_EQ(zero.offer(vals.begin(), vals.end()), (SizeType)0);
+    EXPECT_TRUE(zero.isEmpty());
+}
+
+TEST(TopK, Smallest) {
+    TopK<int, std::less_equal<int>, 4> topK(4);
+    vector<int> vals = {9, 3, 7, 1, 8, 2, 6};
+    EXPECT_EQ(topK.offer(vals.begin(), vals.end()), (SizeType)7);
+    EXPECT_EQ(topK.getThreshold(), 6);
+    EXPECT_EQ(topK.extractSorted(), vector<int>({1, 2, 3, 6}));
+}
+
+TEST(TopK, Range) {
+    const int SIZE = 100000;
+    const SizeType K = 100;
+    vector<int> vals;
+    for (int i = 0; i < SIZE; ++i) {
+        vals.push_back(randInt(0, SIZE));
+    }
+    vector<int> ans(vals);
+    std::sort(ans.begin(), ans.end(), std::greater<int>());
+    ans.resize(K);
+
+    TopK<int> single(K), batch(K), list(K);
+    for (const auto &x : vals) {
+        single.offer(x);
+    }
+    // Offer in slices of different lengths, and through non-random access iterators
+    for (int i = 0; i < SIZE;) {
+        int n = std::min(randInt(0, 1000), SIZE - i);
+        batch.offer(vals.begin() + i, vals.begin() + i + n);
+        i += n;
+    }
+    std::list<int> lst(vals.begin(), vals.end());
+    list.offer(lst.begin(), lst.end());
+    EXPECT_EQ(single.extractSorted(), ans);
+    EXPECT_EQ(batch.extractSorted(), ans);
+    EXPECT_EQ(list.extractSorted(), ans);
+}
+
+struct PtrGreaterEqual {
+    bool operator()(const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) const {
+        return *a >= *b;
+    }
+};
+
+TEST(TopK, Move) {
+    TopK<std::unique_ptr<int>, PtrGreaterEqual> topK(2);
+    for (int i = 0; i < 10; ++i) {
+        topK.offer(std::unique_ptr<int>(new int(i)));
+    }
+    vector<std::unique_ptr<int>> ptrs;
+    ptrs.emplace_back(new int(20));
+    ptrs.emplace_back(new int(-1));
+    EXPECT_EQ(topK.offer(std::make_move_iterator(ptrs.begin()),
+                         std::make_move_iterator(ptrs.end())), (SizeType)1);
+    EXPECT_TRUE(ptrs[0] == nullptr);
+    EXPECT_TRUE(ptrs[1] != nullptr);  // Rejected values are not moved
+    auto res = topK.extractSorted();
+    ASSERT_EQ(res.size(), (SizeType)2);
+    EXPECT_EQ(*res[0], 20);
+    EXPECT_EQ(*res[1], 9);
+
+    TopK<std::string> strTopK(1);
+    strTopK.offer(std::string("a"));
+    std::string s("b");
+    EXPECT_TRUE(strTopK.offer(std::move(s)));
+    EXPECT_EQ(strTopK.getThreshold(), "b");
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "tastylib/util/convert.h"
+#include "tastylib/util/random.h"
+#include "tastylib/UnrolledLinkedList.h"
+#include <string>
+#include <vector>
+
+using tastylib::UnrolledLinkedList;
+using tastylib::toString;
+using tastylib::randInt;
+using std::string;
+using std::vector;
+
+typedef UnrolledLinkedList<int>::SizeType SizeType;
+
+template<typename T, typename Pred, std::size_t ChunkBytes>
+string getListContent(const UnrolledLinkedList<T, Pred, ChunkBytes> &list) {
+    string str;
+    list.traverse([&](const SizeType pos, const T &val) {
+        UNUSED(pos);
+        str += toString(val);
+    });
+    return str;
+}
+
+TEST(UnrolledLinkedList, Basic) {
+    UnrolledLinkedList<int> list;
+    EXPECT_TRUE(list.isEmpty());
+    list.insertBack(1);
+    EXPECT_STREQ(getListContent(list).c_str(), "1");
+    list.insertFront(2);
+    EXPECT_STREQ(getListContent(list).c_str(), "21");
+    list.insert(1, 3);
+    EXPECT_STREQ(getListContent(list).c_str(), "231");
+    list.insert(3, 4);
+    EXPECT_STREQ(getListContent(list).c_str(), "2314");
+    list.sort();
+    EXPECT_STREQ(getListContent(list).c_str(), "1234");
+    int p1 = list.find(3);
+    EXPECT_EQ(p1, 2);
+    list.remove(p1);
+    EXPECT_STREQ(getListContent(list).c_str(), "124");
+    list.removeFront();
+    EXPECT_STREQ(getListContent(list).c_str(), "24");
+    list.removeBack();
+    EXPECT_STREQ(getListContent(list).c_str(), "2");
+    int p2 = list.find(3);
+    EXPECT_EQ(p2, -1);
+    EXPECT_EQ(list.getSize(), (SizeType)1);
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.getSize(), (SizeType)0);
+}
+
+TEST(UnrolledLinkedList, SplitMerge) {
+    // Four values per chunk
+    UnrolledLinkedList<int, std::equal_to<int>, 4 * sizeof(int)> list;
+    EXPECT_EQ(list.CHUNK_CAPACITY, (SizeType)4);
+    for (int i = 1; i < 10; ++i) {
+        list.insertBack(i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        list.insert(2 * i + 1, 0);
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "10203040506070809");
+    list.insert(0, 1);
+    list.insert(100, 9);
+    EXPECT_STREQ(getListContent(list).c_str(), "1102030405060708099");
+    EXPECT_EQ(list.find(9), 17);
+    for (int i = 0; i < 8; ++i) {
+        list.remove(i + 2);
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "11234567899");
+    while (list.getSize() > 1) {
+        list.remove(list.getSize() / 2);
+    }
+    EXPECT_STREQ(getListContent(list).c_str(), "1");
+    list.removeBack();
+    list.removeBack();
+    EXPECT_TRUE(list.isEmpty());
+}
+
+TEST(UnrolledLinkedList, Sort) {
+    UnrolledLinkedList<string> list;
+    list.sort();
+    EXPECT_TRUE(list.isEmpty());
+    for (int i = 0; i < 100; ++i) {
+        list.insertFront(toString(i % 10));
+    }
+    list.sort(std::greater<string>());
+    string ans;
+    for (int i = 9; i >= 0; --i) {
+        ans += string(10, (char)('0' + i));
+    }
+    EXPECT_EQ(getListContent(list), ans);
+}
+
+TEST(UnrolledLinkedList, Random) {
+    UnrolledLinkedList<int, std::equal_to<int>, 8 * sizeof(int)> list;
+    vector<int> ans;
+    for (int i = 0; i < 5000; ++i) {
+        int op = randInt(0, 5);
+        SizeType pos = randInt<SizeType>(0, ans.size());
+        if (op == 0) {
+            list.insertFront(i);
+            ans.insert(ans.begin(), i);
+        } else if (op == 1) {
+            list.insertBack(i);
+            ans.push_back(i);
+        } else if (op == 2) {
+            list.insert(pos, i);
+            ans.insert(ans.begin() + pos, i);
+        } else if (op == 3 && !ans.empty()) {
+            list.removeFront();
+            ans.erase(ans.begin());
+        } else if (op == 4 && !ans.empty()) {
+            list.removeBack();
+            ans.pop_back();
+        } else if (pos < ans.size()) {
+            list.remove(pos);
+            ans.erase(ans.begin() + pos);
+        }
+    }
+    ASSERT_EQ(list.getSize(), ans.size());
+    bool correct = true;
+    list.traverse([&](const SizeType pos, const int &val) {
+        correct = correct && ans[pos] == val;
+    });
+    EXPECT_TRUE(correct);
+}